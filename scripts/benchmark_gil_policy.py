@@ -0,0 +1,52 @@
+"""Measure the per-call cost of releasing the GIL on small getters.
+
+Usage: python scripts/benchmark_gil_policy.py [n_calls]
+"""
+
+from __future__ import annotations
+
+import sys
+import timeit
+from pathlib import Path
+
+import pymmcore_nano as pmn
+
+CONFIG = Path(__file__).parent.parent / "tests" / "MMConfig_demo.cfg"
+GETTERS = {
+    "getTimeoutMs": (),
+    "getAutoShutter": (),
+    "getChannelGroup": (),
+    "getPropertyFromCache": ("Camera", "Binning"),
+    "getExposure": (),
+    "getImageWidth": (),
+}
+
+
+def _per_call_ns(core: pmn.CMMCore, name: str, args: tuple, n: int) -> float:
+    fn = getattr(core, name)
+    best = min(timeit.repeat(lambda: fn(*args), number=n, repeat=5))
+    return best / n * 1e9
+
+
+def main(n: int = 100_000) -> None:
+    from mm_test_adapters import device_adapter_path
+
+    core = pmn.CMMCore()
+    core.setDeviceAdapterSearchPaths([str(device_adapter_path())])
+    core.loadSystemConfiguration(str(CONFIG))
+
+    print(f"{'method':<24}{'release (ns)':>14}{'hold (ns)':>12}{'saved':>9}")
+    for name, args in GETTERS.items():
+        try:
+            pmn.setGILPolicy(name, True)
+            released = _per_call_ns(core, name, args, n)
+            pmn.setGILPolicy(name, False)
+            held = _per_call_ns(core, name, args, n)
+        finally:
+            pmn.resetGILPolicy()
+        saved = 1 - held / released
+        print(f"{name:<24}{released:>14.0f}{held:>12.0f}{saved:>9.0%}")
+
+
+if __name__ == "__main__":
+    main(*(int(a) for a in sys.argv[1:2]))
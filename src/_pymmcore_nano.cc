@@ -1,11 +1,50 @@
 #include <nanobind/make_iterator.h>
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
+#include <nanobind/stl/map.h>
+#include <nanobind/stl/optional.h>
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/tuple.h>
 #include <nanobind/stl/vector.h>
 #include <nanobind/trampoline.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include <lz4.h>
+#include <msgpack.hpp>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "ImageMetadata.h"
 #include "LogLevel.h"
 #include "MMCore.h"
@@ -23,14 +62,112 @@ const std::string PYMMCORE_NANO_VERSION = "1";
 // If you define HOLD_GIL in your build (e.g. -DHOLD_GIL),
 // then the GIL will be held for the duration of all calls into C++ from
 // Python.  By default, the GIL is released for most calls into C++ from Python.
+//
+// Otherwise, whether a method releases the GIL is looked up at call time in a
+// table keyed by method name (see setGILPolicy), so it can be changed at
+// runtime.  RGIL(name) registers the method in that table.
 #ifdef HOLD_GIL
-#define RGIL
+#define RGIL(name)
 #define GIL_HELD 1
 #else
-#define RGIL , nb::call_guard<nb::gil_scoped_release>()
+#define RGIL(name) , gil_policy_guard<__LINE__>(name)
 #define GIL_HELD 0
 #endif
 
+// Methods that only read state kept by CMMCore itself and are cheaper than
+// releasing the GIL.  All other methods release it by default: holding the
+// GIL while waiting for a device module lock can deadlock with a device
+// thread that calls back into Python.
+const std::set<std::string> GIL_HOLD_BY_DEFAULT = {
+    "debugLogEnabled",
+    "getAutoShutter",
+    "getAvailableConfigGroups",
+    "getAvailableConfigs",
+    "getAvailablePixelSizeConfigs",
+    "getBufferFreeCapacity",
+    "getBufferTotalCapacity",
+    "getChannelGroup",
+    "getCircularBufferMemoryFootprint",
+    "getConfigGroupStateFromCache",
+    "getCurrentConfigFromCache",
+    "getDeviceAdapterSearchPaths",
+    "getLoadedDevices",
+    "getMMCoreVersionMajor",
+    "getMMCoreVersionMinor",
+    "getMMCoreVersionPatch",
+    "getMMDeviceDeviceInterfaceVersion",
+    "getMMDeviceModuleInterfaceVersion",
+    "getPrimaryLogFile",
+    "getPrimaryLogLevel",
+    "getPropertyFromCache",
+    "getRemainingImageCount",
+    "getStderrLogLevel",
+    "getSystemStateCache",
+    "getTimeoutMs",
+    "isBufferOverflowed",
+    "isConfigDefined",
+    "isFeatureEnabled",
+    "isGroupDefined",
+    "isPixelSizeConfigDefined",
+    "stderrLogEnabled",
+};
+
+struct GilPolicy {
+    GilPolicy(bool release) : release(release), releaseByDefault(release) {}
+    std::atomic<bool> release;
+    const bool releaseByDefault;
+};
+
+// Filled while the module is initialized; afterwards only the flags change,
+// so lookups need no lock.
+std::map<std::string, GilPolicy> &gil_policies() {
+    static std::map<std::string, GilPolicy> policies;
+    return policies;
+}
+
+// Call guard that releases the GIL if the policy of the method bound on line
+// `Line` says so.
+template <int Line> struct gil_policy_release {
+    static inline const std::atomic<bool> *release = nullptr;
+
+    gil_policy_release() {
+        if (release->load(std::memory_order_relaxed))
+            released_.emplace();
+    }
+
+    std::optional<nb::gil_scoped_release> released_;
+};
+
+// Registers `name` in the policy table and returns its flag, or null if built
+// with HOLD_GIL.
+const std::atomic<bool> *gil_policy_flag(const char *name) {
+#ifdef HOLD_GIL
+    (void)name;
+    return nullptr;
+#else
+    bool release = GIL_HOLD_BY_DEFAULT.count(name) == 0;
+    // std::map nodes are stable, and overloads of a method share one entry.
+    return &gil_policies().try_emplace(name, release).first->second.release;
+#endif
+}
+
+template <int Line> nb::call_guard<gil_policy_release<Line>> gil_policy_guard(const char *name) {
+    gil_policy_release<Line>::release = gil_policy_flag(name);
+    return {};
+}
+
+// For methods that need the GIL for part of their work and so release it
+// themselves: releases the GIL for its lifetime if the flag that the method
+// captured from gil_policy_flag(name) at binding time says so.
+struct gil_policy_scope {
+    explicit gil_policy_scope(const std::atomic<bool> *release) {
+        if (release && release->load(std::memory_order_relaxed))
+            released_.emplace();
+    }
+
+    std::optional<nb::gil_scoped_release> released_;
+};
+
 ///////////////// NUMPY ARRAY HELPERS ///////////////////
 
 // Alias for read-only NumPy array
@@ -55,6 +192,241 @@ np_array make_np_array_from_copy(const void *src, size_t nbytes,
     return np_array(raw_ptr + offset, shape, owner, strides, dtype);
 }
 
+struct ImageGeometry {
+    unsigned width, height, bytesPerPixel, numComponents;
+};
+
+struct ImageRect {
+    unsigned x, y, width, height;
+};
+
+/**
+ * @brief Wraps channel values in read-only arrays shaped like camera images of
+ * the sizes of `rects`, stored one after another in `values`: (height, width),
+ * or (height, width, 3) viewing BGRA data as RGB.  The arrays share one buffer.
+ */
+template <typename T>
+std::vector<np_array> owned_images(std::vector<T> values, const std::vector<ImageRect> &rects,
+                                   unsigned numComponents) {
+    nb::gil_scoped_acquire gil;
+    auto *data = new std::vector<T>(std::move(values));
+    nb::capsule owner(data, [](void *p) noexcept { delete static_cast<std::vector<T> *>(p); });
+    std::vector<np_array> images;
+    images.reserve(rects.size());
+    T *origin = data->data();
+    for (const ImageRect &r : rects) {
+        if (numComponents == 4)
+            images.push_back(np_array(origin + 2, {r.height, r.width, 3}, owner,
+                                      {int64_t(r.width) * 4, 4, -1}, nb::dtype<T>()));
+        else
+            images.push_back(np_array(origin, {r.height, r.width}, owner,
+                                      {int64_t(r.width), 1}, nb::dtype<T>()));
+        origin += size_t(r.width) * r.height * (numComponents == 4 ? 4 : 1);
+    }
+    return images;
+}
+
+// Same, for a single image of geometry `g`.
+template <typename T> np_array owned_image(std::vector<T> values, const ImageGeometry &g) {
+    return owned_images(std::move(values), {{0, 0, g.width, g.height}}, g.numComponents).front();
+}
+
+/** @brief Rectangles copied out of a camera's frames by the *ROIs getters. */
+struct SoftwareROI {
+    std::vector<ImageRect> rects;
+};
+
+/**
+ * @brief Dark-frame, flat-field and hot-pixel correction for one camera.
+ *
+ * `gain` holds the normalized flat field, mean(flat - dark) / (flat - dark),
+ * so correcting a frame is a single subtract-multiply pass over the raw
+ * pixels.  Empty maps are skipped.
+ */
+struct FrameCorrection {
+    unsigned width = 0, height = 0;
+    std::vector<float> dark;
+    std::vector<float> gain;
+    std::vector<size_t> hotPixels; // row-major pixel indices
+    bool nativeOutput = false;     // camera pixel type instead of float32
+};
+
+struct FrameSettings {
+    std::shared_ptr<const FrameCorrection> correction;
+    std::shared_ptr<const SoftwareROI> roi;
+};
+
+// Defined with the per-core binding state; returns the settings registered
+// for the camera that took the frame (from metadata, else the current camera).
+FrameSettings find_frame_settings(CMMCore &core, const Metadata *md);
+
+template <typename Out> Out corrected_value(float v) {
+    if constexpr (std::is_floating_point_v<Out>) {
+        return v;
+    } else {
+        constexpr float top = static_cast<float>(std::numeric_limits<Out>::max());
+        v = std::max(v, 0.0f) + 0.5f;
+        return v >= top ? std::numeric_limits<Out>::max() : static_cast<Out>(v);
+    }
+}
+
+// Corrects rectangle `r` of the full frame `raw` into `out` (r.width x
+// r.height pixels of C values).  BGRA frames (C = 4) apply the maps to each
+// color channel and zero alpha.  One branch-free loop per combination of maps,
+// so each vectorizes.
+template <unsigned C, typename Pix, typename Out>
+void apply_frame_correction(const FrameCorrection &c, const Pix *raw, const ImageRect &r,
+                            Out *out) {
+    constexpr unsigned channels = C == 4 ? 3 : 1;
+    bool hasDark = !c.dark.empty(), hasGain = !c.gain.empty();
+    for (unsigned y = 0; y < r.height; ++y) {
+        size_t offset = size_t(r.y + y) * c.width + r.x;
+        const Pix *in = raw + offset * C;
+        const float *dark = hasDark ? c.dark.data() + offset : nullptr;
+        const float *gain = hasGain ? c.gain.data() + offset : nullptr;
+        Out *row = out + size_t(y) * r.width * C;
+        for (unsigned k = 0; k < channels; ++k) {
+            if (hasDark && hasGain) {
+                for (unsigned i = 0; i < r.width; ++i)
+                    row[i * C + k] = corrected_value<Out>(
+                        (static_cast<float>(in[i * C + k]) - dark[i]) * gain[i]);
+            } else if (hasDark) {
+                for (unsigned i = 0; i < r.width; ++i)
+                    row[i * C + k] =
+                        corrected_value<Out>(static_cast<float>(in[i * C + k]) - dark[i]);
+            } else if (hasGain) {
+                for (unsigned i = 0; i < r.width; ++i)
+                    row[i * C + k] =
+                        corrected_value<Out>(static_cast<float>(in[i * C + k]) * gain[i]);
+            } else {
+                for (unsigned i = 0; i < r.width; ++i)
+                    row[i * C + k] = corrected_value<Out>(static_cast<float>(in[i * C + k]));
+            }
+        }
+        if constexpr (C == 4)
+            for (unsigned i = 0; i < r.width; ++i)
+                row[i * C + 3] = Out(0);
+    }
+    // Hot pixels are replaced by the mean of their (corrected) 4-neighbours
+    // within the rectangle.
+    for (size_t idx : c.hotPixels) {
+        size_t frameRow = idx / c.width, frameCol = idx % c.width;
+        if (frameRow < r.y || frameRow >= r.y + r.height || frameCol < r.x ||
+            frameCol >= r.x + r.width)
+            continue;
+        size_t row = frameRow - r.y, col = frameCol - r.x, i = (row * r.width + col) * C;
+        size_t rowStride = size_t(r.width) * C;
+        for (unsigned k = 0; k < channels; ++k) {
+            float sum = 0;
+            int n = 0;
+            if (col > 0)
+                sum += out[i + k - C], ++n;
+            if (col + 1 < r.width)
+                sum += out[i + k + C], ++n;
+            if (row > 0)
+                sum += out[i + k - rowStride], ++n;
+            if (row + 1 < r.height)
+                sum += out[i + k + rowStride], ++n;
+            if (n > 0)
+                out[i + k] = corrected_value<Out>(sum / n);
+        }
+    }
+}
+
+template <unsigned C, typename Pix, typename Out>
+std::vector<np_array> corrected_np_arrays(const FrameCorrection &c, const void *pBuf,
+                                          const std::vector<ImageRect> &rects) {
+    size_t total = 0;
+    for (const ImageRect &r : rects)
+        total += size_t(r.width) * r.height * C;
+    std::vector<Out> out(total);
+    Out *dst = out.data();
+    for (const ImageRect &r : rects) {
+        apply_frame_correction<C>(c, static_cast<const Pix *>(pBuf), r, dst);
+        dst += size_t(r.width) * r.height * C;
+    }
+    return owned_images(std::move(out), rects, C);
+}
+
+template <typename Pix, typename Out>
+std::vector<np_array> corrected_np_arrays(const FrameCorrection &c, const void *pBuf,
+                                          unsigned numComponents,
+                                          const std::vector<ImageRect> &rects) {
+    return numComponents == 4 ? corrected_np_arrays<4, Pix, Out>(c, pBuf, rects)
+                              : corrected_np_arrays<1, Pix, Out>(c, pBuf, rects);
+}
+
+/**
+ * @brief Creates read-only NumPy arrays holding the corrected copy of the
+ * given rectangles of an image; RGB images are corrected per channel.  The
+ * correction is fused into the copy, so it costs no extra pass over the frame.
+ */
+std::vector<np_array> build_corrected_np_arrays(const FrameCorrection &c, const void *pBuf,
+                                                const ImageGeometry &g,
+                                                const std::vector<ImageRect> &rects) {
+    if (g.width != c.width || g.height != c.height)
+        throw std::runtime_error("Frame correction maps are " + std::to_string(c.width) + "x" +
+                                 std::to_string(c.height) + " but the image is " +
+                                 std::to_string(g.width) + "x" + std::to_string(g.height));
+    unsigned n = g.numComponents;
+    switch (n == 4 ? g.bytesPerPixel / 4 : g.bytesPerPixel) {
+    case 1:
+        return c.nativeOutput ? corrected_np_arrays<uint8_t, uint8_t>(c, pBuf, n, rects)
+                              : corrected_np_arrays<uint8_t, float>(c, pBuf, n, rects);
+    case 2:
+        return c.nativeOutput ? corrected_np_arrays<uint16_t, uint16_t>(c, pBuf, n, rects)
+                              : corrected_np_arrays<uint16_t, float>(c, pBuf, n, rects);
+    case 4:
+        return c.nativeOutput ? corrected_np_arrays<uint32_t, uint32_t>(c, pBuf, n, rects)
+                              : corrected_np_arrays<uint32_t, float>(c, pBuf, n, rects);
+    default: throw std::invalid_argument("Unsupported element size");
+    }
+}
+
+template <typename T>
+std::vector<np_array> cropped_np_arrays(const void *pBuf, const ImageGeometry &g,
+                                        const std::vector<ImageRect> &rects) {
+    size_t components = g.numComponents == 4 ? 4 : 1;
+    size_t total = 0;
+    for (const ImageRect &r : rects)
+        total += size_t(r.width) * r.height * components;
+    std::vector<T> out(total);
+    T *dst = out.data();
+    for (const ImageRect &r : rects) {
+        size_t rowValues = size_t(r.width) * components;
+        for (unsigned y = 0; y < r.height; ++y, dst += rowValues) {
+            size_t offset = (size_t(r.y + y) * g.width + r.x) * components;
+            std::memcpy(dst, static_cast<const T *>(pBuf) + offset, rowValues * sizeof(T));
+        }
+    }
+    return owned_images(std::move(out), rects, g.numComponents);
+}
+
+/**
+ * @brief Copies only the software ROI rectangles of an image, in a single
+ * pass into one buffer, and returns one array per rectangle shaped like a
+ * camera image of its size.  Images are corrected on the way if `correction`
+ * is set.
+ */
+std::vector<np_array> build_roi_arrays(const SoftwareROI &roi, const FrameCorrection *correction,
+                                       const void *pBuf, const ImageGeometry &g) {
+    for (const ImageRect &r : roi.rects)
+        if (size_t(r.x) + r.width > g.width || size_t(r.y) + r.height > g.height)
+            throw std::runtime_error("Software ROI (" + std::to_string(r.x) + ", " +
+                                     std::to_string(r.y) + ", " + std::to_string(r.width) +
+                                     ", " + std::to_string(r.height) +
+                                     ") exceeds the " + std::to_string(g.width) + "x" +
+                                     std::to_string(g.height) + " image");
+    if (correction)
+        return build_corrected_np_arrays(*correction, pBuf, g, roi.rects);
+    switch (g.numComponents == 4 ? g.bytesPerPixel / 4 : g.bytesPerPixel) {
+    case 1: return cropped_np_arrays<uint8_t>(pBuf, g, roi.rects);
+    case 2: return cropped_np_arrays<uint16_t>(pBuf, g, roi.rects);
+    case 4: return cropped_np_arrays<uint32_t>(pBuf, g, roi.rects);
+    default: throw std::invalid_argument("Unsupported element size");
+    }
+}
+
 /**
  * @brief Creates a read-only NumPy array for pBuf for a given width, height,
  * etc. These parameters are are gleaned either from image metadata or core
@@ -62,7 +434,13 @@ np_array make_np_array_from_copy(const void *src, size_t nbytes,
  *
  */
 np_array build_grayscale_np_array(CMMCore &core, void *pBuf, unsigned width, unsigned height,
-                                  unsigned byteDepth) {
+                                  unsigned byteDepth,
+                                  const FrameCorrection *correction = nullptr) {
+    if (correction)
+        return build_corrected_np_arrays(*correction, pBuf, {width, height, byteDepth, 1},
+                                         {{0, 0, width, height}})
+            .front();
+
     std::initializer_list<size_t> shape = {height, width};
     std::initializer_list<int64_t> strides = {width, 1};
 
@@ -84,7 +462,12 @@ np_array build_grayscale_np_array(CMMCore &core, void *pBuf, unsigned width, uns
 // trying to create std::initializer_list dynamically based on numComponents
 // (only on Linux) so we create two constructors
 np_array build_rgb_np_array(CMMCore &core, void *pBuf, unsigned width, unsigned height,
-                            unsigned byteDepth) {
+                            unsigned byteDepth, const FrameCorrection *correction = nullptr) {
+    if (correction)
+        return build_corrected_np_arrays(*correction, pBuf, {width, height, byteDepth, 4},
+                                         {{0, 0, width, height}})
+            .front();
+
     // The source is in BGRA order with 4 components per pixel.
     // We will create a view that skips the alpha channel and inverts the order.
     const unsigned out_byteDepth = byteDepth / 4;
@@ -121,20 +504,22 @@ np_array create_image_array(CMMCore &core, void *pBuf) {
     unsigned height = core.getImageHeight();
     unsigned bytesPerPixel = core.getBytesPerPixel();
     unsigned numComponents = core.getNumberOfComponents();
+    FrameSettings settings = find_frame_settings(core, nullptr);
     if (numComponents == 4) {
-        return build_rgb_np_array(core, pBuf, width, height, bytesPerPixel);
+        return build_rgb_np_array(core, pBuf, width, height, bytesPerPixel,
+                                  settings.correction.get());
     } else {
-        return build_grayscale_np_array(core, pBuf, width, height, bytesPerPixel);
+        return build_grayscale_np_array(core, pBuf, width, height, bytesPerPixel,
+                                        settings.correction.get());
     }
 }
 
 /**
- * @brief Creates a read-only NumPy array for pBuf by using
- * width/height/pixelType from a metadata object if possible, otherwise falls
- * back to core methods.
+ * @brief Reads width/height/pixelType from a metadata object if possible,
+ * otherwise falls back to core methods.
  *
  */
-np_array create_metadata_array(CMMCore &core, void *pBuf, const Metadata md) {
+ImageGeometry metadata_image_geometry(CMMCore &core, const Metadata &md) {
     std::string width_str, height_str, pixel_type;
     unsigned width = 0, height = 0;
     unsigned bytesPerPixel, numComponents = 1;
@@ -166,50 +551,2996 @@ np_array create_metadata_array(CMMCore &core, void *pBuf, const Metadata md) {
     } catch (...) {
         // The metadata doesn't have what we need to shape the array...
         // Fallback to core.getImageWidth etc...
-        return create_image_array(core, pBuf);
+        return {core.getImageWidth(), core.getImageHeight(), core.getBytesPerPixel(),
+                core.getNumberOfComponents()};
     }
-    if (numComponents == 4) {
-        return build_rgb_np_array(core, pBuf, width, height, bytesPerPixel);
+    return {width, height, bytesPerPixel, numComponents};
+}
+
+/**
+ * @brief Creates a read-only NumPy array for pBuf by using
+ * width/height/pixelType from a metadata object if possible, otherwise falls
+ * back to core methods.
+ *
+ */
+np_array create_metadata_array(CMMCore &core, void *pBuf, const Metadata md) {
+    ImageGeometry g = metadata_image_geometry(core, md);
+    FrameSettings settings = find_frame_settings(core, &md);
+    if (g.numComponents == 4) {
+        return build_rgb_np_array(core, pBuf, g.width, g.height, g.bytesPerPixel,
+                                  settings.correction.get());
+    } else {
+        return build_grayscale_np_array(core, pBuf, g.width, g.height, g.bytesPerPixel,
+                                        settings.correction.get());
+    }
+}
+
+/**
+ * @brief Copies the software ROI rectangles of the camera that took the frame
+ * (see create_metadata_array; `md` may be null) into one array each.  Without
+ * a software ROI the list holds the whole frame.
+ */
+std::vector<np_array> create_roi_arrays(CMMCore &core, void *pBuf, const Metadata *md) {
+    ImageGeometry g = md ? metadata_image_geometry(core, *md)
+                         : ImageGeometry{core.getImageWidth(), core.getImageHeight(),
+                                         core.getBytesPerPixel(), core.getNumberOfComponents()};
+    FrameSettings settings = find_frame_settings(core, md);
+    SoftwareROI frame{{{0, 0, g.width, g.height}}};
+    return build_roi_arrays(settings.roi ? *settings.roi : frame, settings.correction.get(),
+                            pBuf, g);
+}
+
+/**
+ * @brief Copies `arr` into a new C-contiguous buffer owned by the returned
+ * capsule.  Used where a consumer rejects negative strides.
+ */
+nb::capsule contiguous_copy(const np_array &arr, void *&data) {
+    const size_t ndim = arr.ndim();
+    const size_t itemsize = arr.itemsize();
+    std::vector<int64_t> byteStrides(ndim);
+    for (size_t i = 0; i < ndim; ++i)
+        byteStrides[i] = arr.stride(i) * static_cast<int64_t>(itemsize);
+    auto buffer = std::make_unique<uint8_t[]>(arr.size() * itemsize);
+    uint8_t *out = buffer.get();
+    // Walk the source in C order; the innermost axis is copied item by item.
+    auto copy = [&](auto &self, const uint8_t *src, size_t axis) -> void {
+        for (size_t i = 0; i < arr.shape(axis); ++i, src += byteStrides[axis]) {
+            if (axis + 1 < ndim) {
+                self(self, src, axis + 1);
+            } else {
+                std::memcpy(out, src, itemsize);
+                out += itemsize;
+            }
+        }
+    };
+    if (arr.size() > 0)
+        copy(copy, static_cast<const uint8_t *>(arr.data()), 0);
+    data = buffer.release();
+    return nb::capsule(data, [](void *p) noexcept { delete[] static_cast<uint8_t *>(p); });
+}
+
+/**
+ * @brief Re-exports a frame for another array framework.
+ *
+ * "numpy" returns the array itself, "dlpack" a framework-neutral nanobind
+ * ndarray (buffer protocol and `__dlpack__`), "torch" and "jax" a tensor of
+ * that framework.  The new object keeps the NumPy array, and so the pixels,
+ * alive.  Frames are shared without copying, except that views with negative
+ * strides (RGB frames viewing BGRA data) are copied for torch and jax, which
+ * reject them.  Must be called with the GIL held.
+ */
+nb::object to_framework(np_array arr, const std::string &framework) {
+    nb::object base = nb::cast(arr);
+    if (framework == "numpy")
+        return base;
+    size_t ndim = arr.ndim();
+    std::vector<size_t> shape(ndim);
+    std::vector<int64_t> strides(ndim);
+    bool negative = false;
+    for (size_t i = 0; i < ndim; ++i) {
+        shape[i] = arr.shape(i);
+        strides[i] = arr.stride(i);
+        negative = negative || strides[i] < 0;
+    }
+    // torch and jax have no read-only tensors; consumers must not write to them.
+    void *data = const_cast<void *>(static_cast<const void *>(arr.data()));
+    if (negative && (framework == "torch" || framework == "jax")) {
+        base = contiguous_copy(arr, data);
+        int64_t stride = 1;
+        for (size_t i = ndim; i-- > 0;) {
+            strides[i] = stride;
+            stride *= static_cast<int64_t>(shape[i]);
+        }
+    }
+    if (framework == "dlpack")
+        return nb::cast(nb::ndarray<nb::ro>(data, ndim, shape.data(), base, strides.data(),
+                                            arr.dtype()));
+    if (framework == "torch")
+        return nb::cast(nb::ndarray<nb::pytorch>(data, ndim, shape.data(), base,
+                                                 strides.data(), arr.dtype()));
+    if (framework == "jax")
+        return nb::cast(
+            nb::ndarray<nb::jax>(data, ndim, shape.data(), base, strides.data(), arr.dtype()));
+    throw std::invalid_argument("framework must be one of 'numpy', 'dlpack', 'torch' or 'jax', "
+                                "not '" + framework + "'");
+}
+
+/**
+ * @brief Runs `get`, which returns a frame's array, with the GIL released and
+ * re-exports it for `framework`.
+ */
+template <typename Get> nb::object framework_image(const std::string &framework, Get &&get) {
+    np_array img;
+    {
+        nb::gil_scoped_release release;
+        img = get();
+    }
+    return to_framework(std::move(img), framework);
+}
+
+/**
+ * @brief Retrieves a frame with `get(copy)`, which fills a copy of the
+ * caller's metadata object `md`, then stores the copy back in `md`.
+ *
+ * `get` usually runs without the GIL, while Python threads may use `md`, so
+ * `md` is only read and written with the GIL held and under its object lock,
+ * the one that nb::lock_self takes in Metadata's own methods.  Called with or
+ * without the GIL.
+ */
+template <typename Get> np_array metadata_image(CMMCore &core, Metadata &md, Get &&get) {
+    Metadata local;
+    {
+        nb::gil_scoped_acquire gil;
+        nb::ft_object_guard guard(nb::find(md));
+        local = md;
+    }
+    void *pixels = get(local);
+    np_array img = create_metadata_array(core, pixels, local);
+    nb::gil_scoped_acquire gil;
+    nb::ft_object_guard guard(nb::find(md));
+    md = local;
+    return img;
+}
+
+// Docstring shared by the image getter overloads taking `framework`.
+const char *const FRAMEWORK_IMAGE_DOC = R"doc(Returns the image as an array of the given `framework`, without copying.
+
+
+`framework` is "numpy", "dlpack" (a framework-neutral array supporting the
+buffer protocol and `__dlpack__`), "torch" or "jax".  Torch and JAX tensors
+share memory with the frame and must not be modified; RGB frames are copied
+for them, as they do not accept the negative strides of the RGB view.
+)doc";
+
+// Same, for the *MD getters that return an (image, metadata) tuple.
+const char *const FRAMEWORK_IMAGE_MD_DOC =
+    R"doc(Returns the image as an array of the given `framework` and its metadata.
+
+
+See the `framework` overload of `getImage`; the image is not copied, except
+for RGB frames exported to torch or JAX.
+)doc";
+
+///////////////// SLM image conversion ///////////////////
+
+// Any-dtype, any-stride CPU array accepted for SLM images.
+using slm_array = nb::ndarray<nb::ro, nb::device::cpu>;
+
+struct SLMFormat {
+    size_t width, height, bytesPerPixel;
+    size_t frameBytes() const { return width * height * bytesPerPixel; }
+};
+
+SLMFormat slm_format(CMMCore &core, const char *slmLabel) {
+    return {core.getSLMWidth(slmLabel), core.getSLMHeight(slmLabel),
+            core.getSLMBytesPerPixel(slmLabel)};
+}
+
+/**
+ * @brief SLM frames in the device's format.
+ *
+ * `frames` points either into the caller's array (when it already is
+ * C-contiguous uint8 in the device layout) or into `storage`.
+ */
+struct SLMFrames {
+    std::vector<unsigned char> storage;
+    std::vector<unsigned char *> frames;
+};
+
+template <typename T> unsigned char to_slm_byte(T v) {
+    if constexpr (std::is_same_v<T, bool>) {
+        return v ? 255 : 0;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        // Float patterns are intensities in [0, 1]; NaN maps to 0.
+        if (!(v > 0))
+            return 0;
+        return v >= 1 ? 255 : static_cast<unsigned char>(std::lround(v * 255));
     } else {
-        return build_grayscale_np_array(core, pBuf, width, height, bytesPerPixel);
+        return static_cast<unsigned char>(v);
+    }
+}
+
+/**
+ * @brief Converts one (H, W) or (H, W, C) frame at `src` with the given byte
+ * strides into `dst`, mapping gray (C == 1) or RGB (C == 3) input to the
+ * SLM's BGRA layout when it has 4 bytes per pixel.
+ *
+ * Strides may be negative (e.g. flipped views), so offsets are computed in
+ * signed arithmetic.
+ */
+template <typename T>
+void convert_slm_frame(const uint8_t *src, const int64_t *strides, size_t channels,
+                       const SLMFormat &fmt, unsigned char *dst) {
+    const size_t bpp = fmt.bytesPerPixel;
+    const int64_t height = static_cast<int64_t>(fmt.height);
+    const int64_t width = static_cast<int64_t>(fmt.width);
+    const int64_t cs = strides[2];
+    auto load = [](const uint8_t *p) { return to_slm_byte(*reinterpret_cast<const T *>(p)); };
+
+    unsigned char *out = dst;
+    if (channels == bpp) {
+        for (int64_t y = 0; y < height; ++y) {
+            const uint8_t *row = src + y * strides[0];
+            for (int64_t x = 0; x < width; ++x, out += bpp) {
+                const uint8_t *px = row + x * strides[1];
+                for (size_t c = 0; c < channels; ++c)
+                    out[c] = load(px + static_cast<int64_t>(c) * cs);
+            }
+        }
+    } else if (channels == 1) { // gray -> BGR, alpha 0
+        for (int64_t y = 0; y < height; ++y) {
+            const uint8_t *row = src + y * strides[0];
+            for (int64_t x = 0; x < width; ++x, out += 4) {
+                out[0] = out[1] = out[2] = load(row + x * strides[1]);
+                out[3] = 0;
+            }
+        }
+    } else { // RGB -> BGR, alpha 0
+        for (int64_t y = 0; y < height; ++y) {
+            const uint8_t *row = src + y * strides[0];
+            for (int64_t x = 0; x < width; ++x, out += 4) {
+                const uint8_t *px = row + x * strides[1];
+                out[0] = load(px + 2 * cs);
+                out[1] = load(px + cs);
+                out[2] = load(px);
+                out[3] = 0;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Validates `pixels` against the SLM format and converts it in a single
+ * pass, copying only when the input is not already in the device layout.
+ *
+ * A single frame is (H, W) or (H, W, C); with `stacked`, a leading frame axis
+ * is expected.  Accepted dtypes are uint8, bool (0/255) and float32/float64
+ * (intensities in [0, 1]); any strides are accepted.
+ */
+SLMFrames prepare_slm_frames(const slm_array &pixels, bool stacked, const SLMFormat &fmt) {
+    const size_t lead = stacked ? 1 : 0;
+    const size_t frameDims = pixels.ndim() - lead;
+    if (pixels.ndim() < lead + 2 || frameDims > 3) {
+        throw std::invalid_argument(
+            std::string("Pixels must be a ") + (stacked ? "3D [n,h,w]" : "2D [h,w]") +
+            " array, or a " + (stacked ? "4D [n,h,w,c]" : "3D [h,w,c]") +
+            " array with c matching the SLM (1, 3 [R,G,B] or its bytes per pixel).");
+    }
+    const size_t n = stacked ? pixels.shape(0) : 1;
+    const size_t height = pixels.shape(lead);
+    const size_t width = pixels.shape(lead + 1);
+    const size_t channels = frameDims == 3 ? pixels.shape(lead + 2) : 1;
+    if (height != fmt.height || width != fmt.width) {
+        throw std::invalid_argument("Image dimensions are wrong for this SLM. Expected (" +
+                                    std::to_string(fmt.height) + ", " +
+                                    std::to_string(fmt.width) + "), but received (" +
+                                    std::to_string(height) + ", " + std::to_string(width) +
+                                    ").");
+    }
+    const size_t bpp = fmt.bytesPerPixel;
+    if (channels != bpp && !(bpp == 4 && (channels == 1 || channels == 3))) {
+        throw std::invalid_argument("Cannot map " + std::to_string(channels) +
+                                    " channel(s) to an SLM with " + std::to_string(bpp) +
+                                    " bytes per pixel. Does this SLM support RGB?");
+    }
+
+    const auto dtype = pixels.dtype();
+    const bool isUint8 = dtype == nb::dtype<uint8_t>();
+    if (!isUint8 && dtype != nb::dtype<bool>() && dtype != nb::dtype<float>() &&
+        dtype != nb::dtype<double>())
+        throw std::invalid_argument("Pixel array type is wrong. Expected uint8, bool, float32 "
+                                    "or float64.");
+
+    // Byte strides of a frame: [row, column, channel], plus the frame stride.
+    const int64_t itemsize = static_cast<int64_t>(pixels.itemsize());
+    int64_t strides[3] = {pixels.stride(lead) * itemsize, pixels.stride(lead + 1) * itemsize,
+                          frameDims == 3 ? pixels.stride(lead + 2) * itemsize : 0};
+    const int64_t frameStride = stacked ? pixels.stride(0) * itemsize : 0;
+    const uint8_t *base = static_cast<const uint8_t *>(pixels.data());
+
+    SLMFrames result;
+    result.frames.reserve(n);
+    const bool deviceLayout =
+        isUint8 && channels == bpp && (channels == 1 || strides[2] == 1) &&
+        strides[1] == static_cast<int64_t>(bpp) &&
+        strides[0] == static_cast<int64_t>(fmt.width * bpp) &&
+        (n <= 1 || frameStride == static_cast<int64_t>(fmt.frameBytes()));
+    if (deviceLayout) {
+        for (size_t i = 0; i < n; ++i)
+            result.frames.push_back(
+                const_cast<unsigned char *>(base + static_cast<int64_t>(i) * frameStride));
+        return result;
+    }
+
+    result.storage.resize(n * fmt.frameBytes());
+    for (size_t i = 0; i < n; ++i) {
+        const uint8_t *src = base + static_cast<int64_t>(i) * frameStride;
+        unsigned char *dst = result.storage.data() + i * fmt.frameBytes();
+        if (isUint8)
+            convert_slm_frame<uint8_t>(src, strides, channels, fmt, dst);
+        else if (dtype == nb::dtype<bool>())
+            convert_slm_frame<bool>(src, strides, channels, fmt, dst);
+        else if (dtype == nb::dtype<float>())
+            convert_slm_frame<float>(src, strides, channels, fmt, dst);
+        else
+            convert_slm_frame<double>(src, strides, channels, fmt, dst);
+        result.frames.push_back(dst);
+    }
+    return result;
+}
+
+///////////////// Columnar Configuration access ///////////////////
+
+// (device labels, property names, values) of a Configuration, as parallel columns.
+using ConfigColumns = std::tuple<StrVec, StrVec, StrVec>;
+
+ConfigColumns config_to_columns(const Configuration &cfg) {
+    ConfigColumns cols;
+    auto &[devices, props, values] = cols;
+    size_t n = cfg.size();
+    devices.reserve(n);
+    props.reserve(n);
+    values.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        PropertySetting s = cfg.getSetting(i);
+        devices.push_back(s.getDeviceLabel());
+        props.push_back(s.getPropertyName());
+        values.push_back(s.getPropertyValue());
+    }
+    return cols;
+}
+
+Configuration config_from_columns(const StrVec &devices, const StrVec &props,
+                                  const StrVec &values) {
+    if (props.size() != devices.size() || values.size() != devices.size())
+        throw std::invalid_argument("devices, properties and values must have the same length");
+    Configuration cfg;
+    for (size_t i = 0; i < devices.size(); ++i)
+        cfg.addSetting(PropertySetting(devices[i].c_str(), props[i].c_str(), values[i].c_str()));
+    return cfg;
+}
+
+///////////////// System configuration helpers ///////////////////
+
+/**
+ * @brief Groups the loaded devices into initialization levels.
+ *
+ * A device depends on its parent hub (`getParentLabel`) and on the serial port
+ * named by its "Port" property, if that port is a loaded device.  Every device
+ * in level N only depends on devices in levels < N, so devices within a level
+ * are independent of each other.
+ */
+std::vector<StrVec> device_init_levels(CMMCore &core) {
+    StrVec labels = core.getLoadedDevices();
+    labels.erase(std::remove(labels.begin(), labels.end(), MM::g_Keyword_CoreDevice),
+                 labels.end());
+    std::set<std::string> loaded(labels.begin(), labels.end());
+
+    std::map<std::string, StrVec> deps;
+    for (const auto &label : labels) {
+        auto &d = deps[label];
+        std::string parent = core.getParentLabel(label.c_str());
+        if (!parent.empty() && parent != label && loaded.count(parent))
+            d.push_back(parent);
+        if (core.hasProperty(label.c_str(), MM::g_Keyword_Port)) {
+            std::string port = core.getProperty(label.c_str(), MM::g_Keyword_Port);
+            if (port != label && loaded.count(port))
+                d.push_back(port);
+        }
+    }
+
+    // Longest-path layering; a device cannot sit deeper than labels.size().
+    std::map<std::string, size_t> level;
+    for (const auto &label : labels)
+        level[label] = 0;
+    for (size_t pass = 0;; ++pass) {
+        if (pass > labels.size())
+            throw std::runtime_error("Cyclic hub/port dependency between loaded devices");
+        bool changed = false;
+        for (const auto &label : labels) {
+            for (const auto &dep : deps[label]) {
+                if (level[label] <= level[dep]) {
+                    level[label] = level[dep] + 1;
+                    changed = true;
+                }
+            }
+        }
+        if (!changed)
+            break;
+    }
+
+    std::vector<StrVec> levels;
+    for (const auto &label : labels) {
+        size_t lvl = level[label];
+        if (levels.size() <= lvl)
+            levels.resize(lvl + 1);
+        levels[lvl].push_back(label);
+    }
+    return levels;
+}
+
+using DeviceInitTiming = std::tuple<std::string, double>;
+
+/**
+ * @brief Assigns the default device roles, as CMMCore::initializeAllDevices()
+ * does: the last loaded device of each type becomes the current camera,
+ * shutter, focus stage, etc.
+ */
+void assign_default_roles(CMMCore &core) {
+    for (const auto &label : core.getLoadedDevices()) {
+        const char *l = label.c_str();
+        switch (core.getDeviceType(l)) {
+        case MM::CameraDevice: core.setCameraDevice(l); break;
+        case MM::ShutterDevice: core.setShutterDevice(l); break;
+        case MM::StageDevice: core.setFocusDevice(l); break;
+        case MM::XYStageDevice: core.setXYStageDevice(l); break;
+        case MM::AutoFocusDevice: core.setAutoFocusDevice(l); break;
+        case MM::SLMDevice: core.setSLMDevice(l); break;
+        case MM::GalvoDevice: core.setGalvoDevice(l); break;
+        default: break;
+        }
+    }
+    core.updateSystemStateCache();
+}
+
+/**
+ * @brief Initializes all uninitialized devices in dependency order, assigns
+ * the default roles and returns the time spent on each device.
+ *
+ * Devices are initialized one at a time on the calling thread:
+ * CMMCore::initializeDevice() also updates core-wide state (core properties,
+ * the device manager's bookkeeping) that MMCore does not lock across calls,
+ * and the pinned MMCore offers no way to run only the adapters' Initialize()
+ * concurrently.  MMCore's own process-wide "ParallelDeviceInitialization"
+ * feature does that inside initializeAllDevices().
+ */
+std::vector<DeviceInitTiming> initialize_devices(CMMCore &core) {
+    std::vector<DeviceInitTiming> timings;
+    for (const auto &level : device_init_levels(core)) {
+        for (const auto &label : level) {
+            if (core.getDeviceInitializationState(label.c_str()) !=
+                DeviceInitializationState::Uninitialized)
+                continue;
+            auto t0 = std::chrono::steady_clock::now();
+            core.initializeDevice(label.c_str());
+            std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+            timings.emplace_back(label, dt.count());
+        }
+    }
+    assign_default_roles(core);
+    return timings;
+}
+
+/**
+ * @brief Checks a system configuration file without loading any device.
+ *
+ * Returns one "line N: message" string per problem found: unknown commands,
+ * wrong field counts, non-numeric values, references to undeclared device
+ * labels, duplicate labels and adapters/devices that cannot be found on the
+ * current adapter search path.
+ */
+StrVec validate_system_configuration(CMMCore &core, const std::string &fileName) {
+    std::ifstream is(fileName);
+    if (!is)
+        throw std::invalid_argument("Cannot open configuration file: " + fileName);
+
+    StrVec issues;
+    std::set<std::string> declared;
+    std::map<std::string, StrVec> adapterDevices;
+    StrVec adapterNames = core.getDeviceAdapterNames();
+
+    auto isNumber = [](const std::string &s) {
+        char *end = nullptr;
+        std::strtod(s.c_str(), &end);
+        return !s.empty() && end == s.c_str() + s.size();
+    };
+
+    std::string line;
+    for (size_t lineNo = 1; std::getline(is, line); ++lineNo) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.find_first_not_of(" \t") == std::string::npos || line[0] == '#')
+            continue;
+
+        StrVec tok;
+        std::stringstream ss(line);
+        for (std::string field; std::getline(ss, field, ',');)
+            tok.push_back(field);
+        const std::string &cmd = tok[0];
+        const std::string where = "line " + std::to_string(lineNo) + ": ";
+
+        auto expect = [&](size_t lo, size_t hi) {
+            if (tok.size() < lo || tok.size() > hi) {
+                issues.push_back(where + cmd + " expects " + std::to_string(lo - 1) +
+                                 (hi != lo ? "-" + std::to_string(hi - 1) : "") +
+                                 " fields, got " + std::to_string(tok.size() - 1));
+                return false;
+            }
+            return true;
+        };
+        auto known = [&](const std::string &label) {
+            if (label != MM::g_Keyword_CoreDevice && !declared.count(label))
+                issues.push_back(where + "device \"" + label + "\" is not declared");
+        };
+        auto numeric = [&](const std::string &value) {
+            if (!isNumber(value))
+                issues.push_back(where + "\"" + value + "\" is not a number");
+        };
+
+        if (cmd == MM::g_CFGCommand_Device) {
+            if (!expect(4, 4))
+                continue;
+            const std::string &label = tok[1], &module = tok[2], &name = tok[3];
+            if (!declared.insert(label).second)
+                issues.push_back(where + "duplicate device label \"" + label + "\"");
+            if (std::find(adapterNames.begin(), adapterNames.end(), module) ==
+                adapterNames.end()) {
+                issues.push_back(where + "device adapter \"" + module + "\" not found");
+                continue;
+            }
+            auto it = adapterDevices.find(module);
+            if (it == adapterDevices.end()) {
+                StrVec available;
+                try {
+                    available = core.getAvailableDevices(module.c_str());
+                } catch (const CMMError &e) {
+                    issues.push_back(where + "cannot load adapter \"" + module +
+                                     "\": " + e.getMsg());
+                }
+                it = adapterDevices.emplace(module, std::move(available)).first;
+            }
+            if (!it->second.empty() &&
+                std::find(it->second.begin(), it->second.end(), name) == it->second.end())
+                issues.push_back(where + "adapter \"" + module + "\" has no device \"" +
+                                 name + "\"");
+        } else if (cmd == MM::g_CFGCommand_Property) {
+            if (expect(3, 4))
+                known(tok[1]);
+        } else if (cmd == MM::g_CFGCommand_ParentID) {
+            if (expect(3, 3)) {
+                known(tok[1]);
+                known(tok[2]);
+            }
+        } else if (cmd == MM::g_CFGCommand_Label) {
+            if (expect(4, 4)) {
+                known(tok[1]);
+                numeric(tok[2]);
+            }
+        } else if (cmd == MM::g_CFGCommand_Delay || cmd == MM::g_CFGCommand_FocusDirection) {
+            if (expect(3, 3)) {
+                known(tok[1]);
+                numeric(tok[2]);
+            }
+        } else if (cmd == MM::g_CFGCommand_ConfigGroup) {
+            if (tok.size() > 2 && expect(5, 6))
+                known(tok[3]);
+        } else if (cmd == MM::g_CFGCommand_Configuration ||
+                   cmd == MM::g_CFGCommand_ConfigPixelSize) {
+            if (expect(5, 5))
+                known(tok[2]);
+        } else if (cmd == MM::g_CFGCommand_PixelSize_um ||
+                   cmd == MM::g_CFGCommand_PixelSizedxdz ||
+                   cmd == MM::g_CFGCommand_PixelSizedydz ||
+                   cmd == MM::g_CFGCommand_PixelSizeOptimalZUm) {
+            if (expect(3, 3))
+                numeric(tok[2]);
+        } else if (cmd == MM::g_CFGCommand_PixelSizeAffine) {
+            if (expect(8, 8))
+                for (size_t i = 2; i < tok.size(); ++i)
+                    numeric(tok[i]);
+        } else if (cmd == MM::g_CFGCommand_Equipment || cmd == MM::g_CFGCommand_ImageSynchro) {
+            // obsolete commands, ignored by MMCore
+        } else {
+            issues.push_back(where + "unknown command \"" + cmd + "\"");
+        }
+    }
+    return issues;
+}
+
+///////////////// Binary system snapshots ///////////////////
+
+// Bump when the layout of SystemSnapshot changes.
+const int SNAPSHOT_VERSION = 1;
+
+// (device label, property name, value)
+using SnapshotSetting = std::tuple<std::string, std::string, std::string>;
+using SnapshotSettings = std::vector<SnapshotSetting>;
+
+struct PixelSizeSnapshot {
+    std::string id;
+    SnapshotSettings settings;
+    double sizeUm = 0.0;
+    std::vector<double> affine;
+    double dxdz = 0.0;
+    double dydz = 0.0;
+    double optimalZUm = 0.0;
+    MSGPACK_DEFINE(id, settings, sizeUm, affine, dxdz, dydz, optimalZUm);
+};
+
+struct SystemSnapshot {
+    int version = SNAPSHOT_VERSION;
+    SnapshotSettings properties;
+    std::map<std::string, std::map<std::string, SnapshotSettings>> groups;
+    std::vector<PixelSizeSnapshot> pixelSizes;
+    std::string camera;
+    std::vector<int> roi;
+    double exposure = 0.0;
+    MSGPACK_DEFINE(version, properties, groups, pixelSizes, camera, roi, exposure);
+};
+
+SnapshotSettings snapshot_settings(const Configuration &cfg) {
+    SnapshotSettings settings;
+    settings.reserve(cfg.size());
+    for (size_t i = 0; i < cfg.size(); ++i) {
+        PropertySetting s = cfg.getSetting(i);
+        settings.emplace_back(s.getDeviceLabel(), s.getPropertyName(), s.getPropertyValue());
+    }
+    return settings;
+}
+
+bool same_settings(SnapshotSettings a, SnapshotSettings b) {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    return a == b;
+}
+
+/**
+ * @brief Captures the property cache, config groups, pixel size configs and
+ * camera ROI/exposure.  Only cached values are read; no device is queried.
+ */
+SystemSnapshot capture_snapshot(CMMCore &core) {
+    SystemSnapshot snap;
+    snap.properties = snapshot_settings(core.getSystemStateCache());
+    for (const auto &group : core.getAvailableConfigGroups()) {
+        auto &presets = snap.groups[group];
+        for (const auto &config : core.getAvailableConfigs(group.c_str()))
+            presets[config] =
+                snapshot_settings(core.getConfigData(group.c_str(), config.c_str()));
+    }
+    for (const auto &id : core.getAvailablePixelSizeConfigs()) {
+        PixelSizeSnapshot ps;
+        ps.id = id;
+        ps.settings = snapshot_settings(core.getPixelSizeConfigData(id.c_str()));
+        ps.sizeUm = core.getPixelSizeUmByID(id.c_str());
+        ps.affine = core.getPixelSizeAffineByID(id.c_str());
+        ps.dxdz = core.getPixelSizedxdz(id.c_str());
+        ps.dydz = core.getPixelSizedydz(id.c_str());
+        ps.optimalZUm = core.getPixelSizeOptimalZUm(id.c_str());
+        snap.pixelSizes.push_back(std::move(ps));
+    }
+    snap.camera = core.getCameraDevice();
+    if (!snap.camera.empty()) {
+        int x, y, w, h;
+        core.getROI(x, y, w, h);
+        snap.roi = {x, y, w, h};
+        snap.exposure = core.getExposure();
+    }
+    return snap;
+}
+
+std::string pack_snapshot(const SystemSnapshot &snap) {
+    msgpack::sbuffer buffer;
+    msgpack::pack(buffer, snap);
+    return std::string(buffer.data(), buffer.size());
+}
+
+SystemSnapshot unpack_snapshot(const char *data, size_t size) {
+    SystemSnapshot snap;
+    try {
+        msgpack::object_handle handle = msgpack::unpack(data, size);
+        handle.get().convert(snap);
+    } catch (const std::exception &e) {
+        throw std::invalid_argument(std::string("Invalid system snapshot: ") + e.what());
+    }
+    if (snap.version != SNAPSHOT_VERSION)
+        throw std::invalid_argument("Unsupported system snapshot version " +
+                                    std::to_string(snap.version));
+    return snap;
+}
+
+/**
+ * @brief Brings the core in line with a snapshot, touching only what differs.
+ *
+ * Config groups and pixel size configs are restored first (so that Core
+ * properties such as ChannelGroup can refer to them), then properties, then
+ * the ROI.  Properties of devices that are not loaded, read-only properties
+ * and Core-Initialize are skipped; failures to set a property are logged and
+ * do not abort the restore, as in CMMCore::setSystemState().
+ *
+ * @return The number of changes applied.
+ */
+size_t apply_snapshot(CMMCore &core, const SystemSnapshot &snap) {
+    size_t changes = 0;
+
+    for (const auto &group : core.getAvailableConfigGroups()) {
+        if (!snap.groups.count(group)) {
+            core.deleteConfigGroup(group.c_str());
+            ++changes;
+        }
+    }
+    for (const auto &[group, presets] : snap.groups) {
+        if (!core.isGroupDefined(group.c_str())) {
+            core.defineConfigGroup(group.c_str());
+            ++changes;
+        }
+        for (const auto &config : core.getAvailableConfigs(group.c_str())) {
+            if (!presets.count(config)) {
+                core.deleteConfig(group.c_str(), config.c_str());
+                ++changes;
+            }
+        }
+        for (const auto &[config, settings] : presets) {
+            if (core.isConfigDefined(group.c_str(), config.c_str())) {
+                auto current = snapshot_settings(core.getConfigData(group.c_str(), config.c_str()));
+                if (same_settings(current, settings))
+                    continue;
+                core.deleteConfig(group.c_str(), config.c_str());
+            }
+            core.defineConfig(group.c_str(), config.c_str());
+            for (const auto &[dev, prop, value] : settings)
+                core.defineConfig(group.c_str(), config.c_str(), dev.c_str(), prop.c_str(),
+                                  value.c_str());
+            ++changes;
+        }
+    }
+
+    std::set<std::string> pixelIds;
+    for (const auto &ps : snap.pixelSizes)
+        pixelIds.insert(ps.id);
+    for (const auto &id : core.getAvailablePixelSizeConfigs()) {
+        if (!pixelIds.count(id)) {
+            core.deletePixelSizeConfig(id.c_str());
+            ++changes;
+        }
+    }
+    for (const auto &ps : snap.pixelSizes) {
+        const char *id = ps.id.c_str();
+        if (core.isPixelSizeConfigDefined(id)) {
+            auto current = snapshot_settings(core.getPixelSizeConfigData(id));
+            if (same_settings(current, ps.settings) && core.getPixelSizeUmByID(id) == ps.sizeUm &&
+                core.getPixelSizeAffineByID(id) == ps.affine &&
+                core.getPixelSizedxdz(id) == ps.dxdz && core.getPixelSizedydz(id) == ps.dydz &&
+                core.getPixelSizeOptimalZUm(id) == ps.optimalZUm)
+                continue;
+            core.deletePixelSizeConfig(id);
+        }
+        core.definePixelSizeConfig(id);
+        for (const auto &[dev, prop, value] : ps.settings)
+            core.definePixelSizeConfig(id, dev.c_str(), prop.c_str(), value.c_str());
+        core.setPixelSizeUm(id, ps.sizeUm);
+        if (ps.affine.size() == 6) {
+            std::vector<double> affine = ps.affine;
+            core.setPixelSizeAffine(id, affine);
+        }
+        core.setPixelSizedxdz(id, ps.dxdz);
+        core.setPixelSizedydz(id, ps.dydz);
+        core.setPixelSizeOptimalZUm(id, ps.optimalZUm);
+        ++changes;
+    }
+
+    std::map<std::pair<std::string, std::string>, std::string> cache;
+    for (const auto &[dev, prop, value] : snapshot_settings(core.getSystemStateCache()))
+        cache[{dev, prop}] = value;
+    StrVec loadedVec = core.getLoadedDevices();
+    std::set<std::string> loaded(loadedVec.begin(), loadedVec.end());
+    for (const auto &[dev, prop, value] : snap.properties) {
+        if (!loaded.count(dev) ||
+            (dev == MM::g_Keyword_CoreDevice && prop == MM::g_Keyword_CoreInitialize))
+            continue;
+        auto it = cache.find({dev, prop});
+        if (it != cache.end() && it->second == value)
+            continue;
+        try {
+            if (core.isPropertyReadOnly(dev.c_str(), prop.c_str()))
+                continue;
+            core.setProperty(dev.c_str(), prop.c_str(), value.c_str());
+            ++changes;
+        } catch (const CMMError &e) {
+            core.logMessage(("Snapshot restore: cannot set " + dev + "-" + prop + " to \"" +
+                             value + "\": " + e.getMsg())
+                                .c_str());
+        }
+    }
+
+    if (!snap.camera.empty() && snap.camera == core.getCameraDevice()) {
+        if (core.getExposure() != snap.exposure) {
+            core.setExposure(snap.exposure);
+            ++changes;
+        }
+        if (snap.roi.size() == 4) {
+            int x, y, w, h;
+            core.getROI(x, y, w, h);
+            if (std::vector<int>{x, y, w, h} != snap.roi) {
+                core.setROI(snap.roi[0], snap.roi[1], snap.roi[2], snap.roi[3]);
+                ++changes;
+            }
+        }
+    }
+    return changes;
+}
+
+///////////////// Stage sequence helpers ///////////////////
+
+// 1D float64 array accepted without copying for stage sequences.
+using position_array = nb::ndarray<const double, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * @brief Copies a position array into the vector MMCore expects, checking its
+ * length against the device limit and rejecting non-finite values.
+ */
+std::vector<double> checked_sequence(const position_array &positions, long maxLength,
+                                     const char *what) {
+    const double *data = static_cast<const double *>(positions.data());
+    size_t n = positions.shape(0);
+    if (maxLength >= 0 && n > static_cast<size_t>(maxLength))
+        throw std::invalid_argument(std::string(what) + " has " + std::to_string(n) +
+                                    " positions, but the device accepts at most " +
+                                    std::to_string(maxLength) +
+                                    ". Use StageSequenceStream to load it in chunks.");
+    if (!std::all_of(data, data + n, [](double v) { return std::isfinite(v); }))
+        throw std::invalid_argument(std::string(what) + " contains NaN or infinite values");
+    return std::vector<double>(data, data + n);
+}
+
+/**
+ * @brief Runs a stage (or XY stage) sequence longer than the device limit as
+ * a series of chunks, each at most getStageSequenceMaxLength() long.
+ *
+ * Devices cannot accept a new sequence while one is running, so advance()
+ * stops the current chunk, loads the next one and starts it.  Positions are
+ * copied once at construction and sliced per chunk.  The stage ignores
+ * triggers between the stop and the start, so callers must hold off the
+ * trigger source across advance().
+ */
+class StageSequenceStream {
+  public:
+    StageSequenceStream(CMMCore &core, std::string label, const position_array &positions)
+        : core_(core), label_(std::move(label)), xy_(false) {
+        chunkSize_ = core_.getStageSequenceMaxLength(label_.c_str());
+        x_ = checked_sequence(positions, -1, "positionSequence");
+        init();
+    }
+
+    StageSequenceStream(CMMCore &core, std::string label, const position_array &x,
+                        const position_array &y)
+        : core_(core), label_(std::move(label)), xy_(true) {
+        if (x.shape(0) != y.shape(0))
+            throw std::invalid_argument("xSequence and ySequence must have the same length");
+        chunkSize_ = core_.getXYStageSequenceMaxLength(label_.c_str());
+        x_ = checked_sequence(x, -1, "xSequence");
+        y_ = checked_sequence(y, -1, "ySequence");
+        init();
+    }
+
+    size_t chunkSize() const { return chunkSize_; }
+    size_t chunkCount() const { return (x_.size() + chunkSize_ - 1) / chunkSize_; }
+    // Index of the chunk currently loaded, or -1 before the first advance().
+    long currentChunk() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return static_cast<long>(next_) - 1;
+    }
+
+    // Stops the running chunk (if any), then loads and starts the next one.
+    // Returns false, leaving the stage stopped, once all chunks have run.
+    // Unless `force` is set, refuses to cut off a chunk the stage still
+    // reports busy with.
+    bool advance(bool force) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (next_ > 0) {
+            if (!force && core_.deviceBusy(label_.c_str()))
+                throw std::runtime_error("Stage " + label_ + " is still running chunk " +
+                                         std::to_string(next_ - 1) +
+                                         "; pass force=True to stop it early");
+            stop();
+        }
+        if (next_ >= chunkCount())
+            return false;
+        size_t begin = next_ * chunkSize_;
+        size_t end = std::min(begin + chunkSize_, x_.size());
+        const char *label = label_.c_str();
+        if (xy_) {
+            core_.loadXYStageSequence(label, {x_.begin() + begin, x_.begin() + end},
+                                      {y_.begin() + begin, y_.begin() + end});
+            core_.startXYStageSequence(label);
+        } else {
+            core_.loadStageSequence(label, {x_.begin() + begin, x_.begin() + end});
+            core_.startStageSequence(label);
+        }
+        ++next_;
+        return true;
+    }
+
+    void stop() {
+        if (xy_)
+            core_.stopXYStageSequence(label_.c_str());
+        else
+            core_.stopStageSequence(label_.c_str());
+    }
+
+  private:
+    void init() {
+        if (chunkSize_ == 0)
+            throw std::invalid_argument("Stage " + label_ + " does not support sequences");
+    }
+
+    CMMCore &core_;
+    std::string label_;
+    bool xy_;
+    size_t chunkSize_ = 0;
+    mutable std::mutex mutex_; // serializes advance() across threads
+    size_t next_ = 0;
+    std::vector<double> x_, y_;
+};
+
+///////////////// Tile scanning ///////////////////
+
+// (N, 2) or (N, 3) float64 array of x, y[, z] stage positions.
+using tile_positions = nb::ndarray<const double, nb::ndim<2>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * @brief Snaps one image at each position, overlapping stage moves with
+ * camera readout.
+ *
+ * snapImage() returns once the exposure has ended, so the move to the next
+ * position is issued before getImage() waits for readout and copies the
+ * frame, and the stage keeps moving while the frame callback runs.  Must be
+ * called without the GIL; it is acquired only to invoke the callback.
+ */
+void run_tile_scan(CMMCore &core, const tile_positions &positions,
+                   const nb::callable &callback) {
+    size_t n = positions.shape(0);
+    size_t dims = positions.shape(1);
+    if (dims != 2 && dims != 3)
+        throw std::invalid_argument("positions must have shape (N, 2) or (N, 3), got (N, " +
+                                    std::to_string(dims) + ")");
+    const double *pos = static_cast<const double *>(positions.data());
+    std::string xyStage = core.getXYStageDevice();
+    std::string zStage = dims == 3 ? core.getFocusDevice() : std::string();
+    if (xyStage.empty())
+        throw std::invalid_argument("No XY stage device is set");
+    if (dims == 3 && zStage.empty())
+        throw std::invalid_argument("positions have a z column, but no focus device is set");
+
+    auto moveTo = [&](size_t i) {
+        const double *p = pos + i * dims;
+        core.setXYPosition(xyStage.c_str(), p[0], p[1]);
+        if (dims == 3)
+            core.setPosition(zStage.c_str(), p[2]);
+    };
+    auto waitForStages = [&]() {
+        core.waitForDevice(xyStage.c_str());
+        if (dims == 3)
+            core.waitForDevice(zStage.c_str());
+    };
+
+    if (n == 0)
+        return;
+    moveTo(0);
+    for (size_t i = 0; i < n; ++i) {
+        waitForStages();
+        core.snapImage();
+        if (i + 1 < n)
+            moveTo(i + 1);
+        void *buffer = core.getImage();
+
+        nb::gil_scoped_acquire gil;
+        nb::object image = nb::cast(create_image_array(core, buffer));
+        const double *p = pos + i * dims;
+        nb::tuple where = dims == 3 ? nb::make_tuple(p[0], p[1], p[2])
+                                    : nb::make_tuple(p[0], p[1]);
+        callback(i, image, where);
+    }
+}
+
+///////////////// Stage telemetry ///////////////////
+
+// Takes ownership of `values` and exposes them as a 1D NumPy array.
+// Must be called with the GIL held.
+template <typename T> np_array owned_array(std::vector<T> values) {
+    auto *data = new std::vector<T>(std::move(values));
+    nb::capsule owner(data, [](void *p) noexcept { delete static_cast<std::vector<T> *>(p); });
+    return np_array(data->data(), {data->size()}, owner, {1}, nb::dtype<T>());
+}
+
+/**
+ * @brief Polls an XY stage and/or a focus stage from a background thread at a
+ * fixed rate, keeping timestamped samples in a ring buffer.
+ *
+ * The polling thread only calls into MMCore and never touches Python objects,
+ * so it runs unaffected by the GIL.
+ */
+class StageTelemetry {
+  public:
+    struct Sample {
+        double t, x, y, z;
+    };
+
+    StageTelemetry(CMMCore &core, std::string xyStage, std::string zStage, size_t capacity)
+        : core_(core), xyStage_(std::move(xyStage)), zStage_(std::move(zStage)),
+          ring_(capacity), t0_(std::chrono::steady_clock::now()) {
+        if (capacity == 0)
+            throw std::invalid_argument("capacity must be greater than 0");
+        if (xyStage_.empty() && zStage_.empty())
+            throw std::invalid_argument("At least one of xyStage or zStage must be given");
+    }
+
+    ~StageTelemetry() { stop(); }
+
+    void start(double intervalMs) {
+        if (intervalMs <= 0)
+            throw std::invalid_argument("intervalMs must be positive");
+        std::lock_guard<std::mutex> threadLock(threadMutex_);
+        stopThread();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopRequested_ = false;
+        }
+        auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(intervalMs));
+        thread_ = std::thread([this, interval] { run(interval); });
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> threadLock(threadMutex_);
+        stopThread();
+    }
+
+    bool isRunning() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return !stopRequested_;
+    }
+
+    // Discards all samples and restarts the time base at zero.
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        head_ = count_ = 0;
+        t0_ = std::chrono::steady_clock::now();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+    // Oldest-first copy of the buffered samples.
+    std::vector<Sample> samples() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<Sample> out;
+        out.reserve(count_);
+        size_t first = (head_ + ring_.size() - count_) % ring_.size();
+        for (size_t i = 0; i < count_; ++i)
+            out.push_back(ring_[(first + i) % ring_.size()]);
+        return out;
+    }
+
+  private:
+    // Caller must hold threadMutex_.
+    void stopThread() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopRequested_ = true;
+        }
+        wake_.notify_all();
+        if (thread_.joinable())
+            thread_.join();
+    }
+
+    void run(std::chrono::steady_clock::duration interval) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        auto next = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopRequested_) {
+            lock.unlock();
+            Sample s{0.0, nan, nan, nan};
+            bool ok = true;
+            try {
+                if (!xyStage_.empty())
+                    core_.getXYPosition(xyStage_.c_str(), s.x, s.y);
+                if (!zStage_.empty())
+                    s.z = core_.getPosition(zStage_.c_str());
+            } catch (const CMMError &) {
+                ok = false; // e.g. the device is busy or being unloaded; skip this tick
+            }
+            auto now = std::chrono::steady_clock::now();
+            lock.lock();
+            // A clear() between the read and re-locking moves t0_ past `now`;
+            // that sample belongs to the discarded series, so drop it.
+            if (ok && now >= t0_) {
+                s.t = std::chrono::duration<double>(now - t0_).count();
+                ring_[head_] = s;
+                head_ = (head_ + 1) % ring_.size();
+                count_ = std::min(count_ + 1, ring_.size());
+            }
+            next += interval;
+            if (next < now)
+                next = now; // fell behind; don't try to catch up with a burst
+            wake_.wait_until(lock, next, [this] { return stopRequested_; });
+        }
+    }
+
+    CMMCore &core_;
+    std::string xyStage_, zStage_;
+    std::vector<Sample> ring_;
+    size_t head_ = 0, count_ = 0;
+    std::chrono::steady_clock::time_point t0_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopRequested_ = true;
+    std::mutex threadMutex_; // held for the whole of start() and stop()
+    std::thread thread_;
+};
+
+///////////////// Galvo helpers ///////////////////
+
+// (N, 2) float64 array of x, y galvo coordinates.
+using point_array = nb::ndarray<const double, nb::ndim<2>, nb::shape<-1, 2>, nb::c_contig,
+                                nb::device::cpu>;
+using offset_array = nb::ndarray<const int64_t, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+/**
+ * @brief Replaces the galvo's polygons with those in `vertices`, where polygon
+ * i spans rows [offsets[i], offsets[i + 1]) and the last runs to the end.
+ * A trailing offset equal to the number of vertices is allowed (CSR style).
+ */
+void load_galvo_polygons(CMMCore &core, const char *galvoLabel, const point_array &vertices,
+                         const offset_array &offsets) {
+    const int64_t n = static_cast<int64_t>(vertices.shape(0));
+    const int64_t *off = static_cast<const int64_t *>(offsets.data());
+    size_t nOffsets = offsets.shape(0);
+    if (nOffsets > 0 && off[nOffsets - 1] == n)
+        --nOffsets; // drop the CSR end marker
+    if (nOffsets == 0 && n > 0)
+        throw std::invalid_argument("polygonOffsets must contain at least one offset");
+    for (size_t i = 0; i < nOffsets; ++i) {
+        int64_t prev = i == 0 ? 0 : off[i - 1];
+        if (off[i] < prev || off[i] >= n || (i == 0 && off[i] != 0))
+            throw std::invalid_argument("polygonOffsets must start at 0, be non-decreasing "
+                                        "and lie within the vertex array");
+    }
+
+    const double *v = static_cast<const double *>(vertices.data());
+    core.deleteGalvoPolygons(galvoLabel);
+    for (size_t polygon = 0; polygon < nOffsets; ++polygon) {
+        int64_t end = polygon + 1 < nOffsets ? off[polygon + 1] : n;
+        for (int64_t row = off[polygon]; row < end; ++row)
+            core.addGalvoPolygonVertex(galvoLabel, static_cast<int>(polygon), v[2 * row],
+                                       v[2 * row + 1]);
+    }
+    core.loadGalvoPolygons(galvoLabel);
+}
+
+/**
+ * @brief Fires the galvo at each point, starting point i at i * interval_us
+ * after the first.  Returns the actual start time of each point in seconds.
+ */
+std::vector<double> fire_galvo_points(CMMCore &core, const char *galvoLabel,
+                                      const point_array &points, double pulseTime_us,
+                                      double interval_us) {
+    if (interval_us < 0)
+        throw std::invalid_argument("interval_us must not be negative");
+    using clock = std::chrono::steady_clock;
+    const double *p = static_cast<const double *>(points.data());
+    const size_t n = points.shape(0);
+    const auto interval = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double, std::micro>(interval_us));
+
+    std::vector<double> startTimes;
+    startTimes.reserve(n);
+    const auto t0 = clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        auto target = t0 + static_cast<clock::rep>(i) * interval;
+        // Sleep until shortly before the target, then spin for the remainder.
+        auto coarse = target - std::chrono::milliseconds(1);
+        if (clock::now() < coarse)
+            std::this_thread::sleep_until(coarse);
+        while (clock::now() < target) {
+        }
+        startTimes.push_back(std::chrono::duration<double>(clock::now() - t0).count());
+        core.pointGalvoAndFire(galvoLabel, p[2 * i], p[2 * i + 1], pulseTime_us);
+    }
+    return startTimes;
+}
+
+///////////////// Serial port helpers ///////////////////
+
+/**
+ * @brief Per-port buffers for bytes read from a serial port but not yet
+ * returned to the caller (e.g. past a terminator or beyond a buffer's size).
+ *
+ * Each port has its own mutex, held for the whole duration of a read, so
+ * concurrent reads from one port do not interleave.
+ */
+class SerialReadBuffers {
+  public:
+    struct Port {
+        std::mutex mutex;
+        std::string pending;
+    };
+
+    Port &port(const std::string &label) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &p = ports_[label];
+        if (!p)
+            p = std::make_unique<Port>();
+        return *p;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<Port>> ports_;
+};
+
+// Interval between polls of a serial port that has no data available.
+const auto SERIAL_POLL_INTERVAL = std::chrono::milliseconds(1);
+
+std::chrono::steady_clock::time_point deadline_after(double timeout_ms) {
+    return std::chrono::steady_clock::now() +
+           std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+               std::chrono::duration<double, std::milli>(timeout_ms));
+}
+
+// Appends whatever the port has available to `pending`, sleeping briefly if
+// nothing was available.  Caller must hold the port's mutex.
+void poll_serial(CMMCore &core, const char *portLabel, std::string &pending) {
+    std::vector<char> data = core.readFromSerialPort(portLabel);
+    if (data.empty())
+        std::this_thread::sleep_for(SERIAL_POLL_INTERVAL);
+    else
+        pending.append(data.data(), data.size());
+}
+
+/**
+ * @brief Reads at least `minBytes` (and at most `capacity`) bytes into `out`,
+ * or as many as arrived before the timeout.  Returns the number of bytes read.
+ */
+size_t serial_read_into(CMMCore &core, SerialReadBuffers &buffers, const char *portLabel,
+                        uint8_t *out, size_t capacity, size_t minBytes, double timeout_ms) {
+    if (minBytes > capacity)
+        throw std::invalid_argument("minBytes exceeds the size of the buffer");
+    auto &port = buffers.port(portLabel);
+    std::lock_guard<std::mutex> lock(port.mutex);
+    auto deadline = deadline_after(timeout_ms);
+    while (port.pending.size() < minBytes && std::chrono::steady_clock::now() < deadline)
+        poll_serial(core, portLabel, port.pending);
+    // Also pick up anything else that is already available, up to capacity.
+    if (port.pending.size() < capacity) {
+        std::vector<char> data = core.readFromSerialPort(portLabel);
+        port.pending.append(data.data(), data.size());
+    }
+    size_t n = std::min(port.pending.size(), capacity);
+    std::memcpy(out, port.pending.data(), n);
+    port.pending.erase(0, n);
+    return n;
+}
+
+// Reads up to and including `terminator`; caller must hold the port's mutex.
+std::string read_until_locked(CMMCore &core, SerialReadBuffers::Port &port,
+                              const char *portLabel, const std::string &terminator,
+                              std::chrono::steady_clock::time_point deadline) {
+    size_t searchFrom = 0;
+    for (;;) {
+        size_t pos = port.pending.find(terminator, searchFrom);
+        if (pos != std::string::npos) {
+            size_t end = pos + terminator.size();
+            std::string answer = port.pending.substr(0, end);
+            port.pending.erase(0, end);
+            return answer;
+        }
+        if (std::chrono::steady_clock::now() >= deadline)
+            throw CMMError("Timed out waiting for terminator on serial port " +
+                           std::string(portLabel));
+        // The terminator may straddle the old end of the buffer.
+        searchFrom = port.pending.size() >= terminator.size()
+                         ? port.pending.size() - terminator.size() + 1
+                         : 0;
+        poll_serial(core, portLabel, port.pending);
+    }
+}
+
+/**
+ * @brief Reads up to and including `terminator`.  Throws CMMError if it has
+ * not arrived within the timeout; bytes read so far are kept for the next read.
+ */
+std::string serial_read_until(CMMCore &core, SerialReadBuffers &buffers, const char *portLabel,
+                              const std::string &terminator, double timeout_ms) {
+    if (terminator.empty())
+        throw std::invalid_argument("terminator must not be empty");
+    auto &port = buffers.port(portLabel);
+    std::lock_guard<std::mutex> lock(port.mutex);
+    return read_until_locked(core, port, portLabel, terminator, deadline_after(timeout_ms));
+}
+
+/**
+ * @brief Writes all commands (each followed by `term`) in a single write,
+ * then collects one `term`-terminated answer per command, all within
+ * `timeout_ms`.  Answers are returned without the terminator.
+ */
+std::vector<std::string> serial_transact(CMMCore &core, SerialReadBuffers &buffers,
+                                         const char *portLabel, const StrVec &commands,
+                                         const std::string &term, double timeout_ms) {
+    if (term.empty())
+        throw std::invalid_argument("term must not be empty");
+    std::vector<char> batch;
+    for (const auto &command : commands) {
+        batch.insert(batch.end(), command.begin(), command.end());
+        batch.insert(batch.end(), term.begin(), term.end());
+    }
+    auto &port = buffers.port(portLabel);
+    std::lock_guard<std::mutex> lock(port.mutex);
+    auto deadline = deadline_after(timeout_ms);
+    core.writeToSerialPort(portLabel, batch);
+    std::vector<std::string> answers;
+    answers.reserve(commands.size());
+    for (size_t i = 0; i < commands.size(); ++i) {
+        std::string answer = read_until_locked(core, port, portLabel, term, deadline);
+        answer.resize(answer.size() - term.size());
+        answers.push_back(std::move(answer));
+    }
+    return answers;
+}
+
+///////////////// Per-logger log levels ///////////////////
+
+/**
+ * @brief Minimum log levels for individual loggers (names passed to `log`, or
+ * "App" for `logMessage`), checked before a message is formatted.
+ *
+ * Loggers without a threshold are not filtered here.  The common case of no
+ * thresholds at all is a single atomic load.
+ */
+class LoggerLevels {
+  public:
+    void set(const std::string &logger, mmcore::LogLevel level) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        levels_[logger] = level;
+        any_ = true;
+    }
+
+    void reset(const std::string &logger) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        levels_.erase(logger);
+        any_ = !levels_.empty();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        levels_.clear();
+        any_ = false;
+    }
+
+    std::optional<mmcore::LogLevel> get(const std::string &logger) const {
+        if (!any_)
+            return std::nullopt;
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = levels_.find(logger);
+        if (it == levels_.end())
+            return std::nullopt;
+        return it->second;
+    }
+
+    std::map<std::string, mmcore::LogLevel> all() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return {levels_.begin(), levels_.end()};
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, mmcore::LogLevel> levels_;
+    std::atomic<bool> any_{false};
+};
+
+///////////////// In-memory log sink ///////////////////
+
+struct LogRecord {
+    double time;   // seconds since the epoch
+    int level;     // mmcore::LogLevel
+    uint64_t thread;
+    std::string logger;
+    std::string message;
+};
+
+// Days from 1970-01-01 to the given proleptic Gregorian date.
+int64_t days_from_civil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    unsigned yoe = static_cast<unsigned>(y - era * 400);
+    unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+// Offset of local time from UTC at `t`, in seconds.
+int64_t utc_offset(std::time_t t) {
+    std::tm local{}, utc{};
+#ifdef _WIN32
+    localtime_s(&local, &t);
+    gmtime_s(&utc, &t);
+#else
+    localtime_r(&t, &local);
+    gmtime_r(&t, &utc);
+#endif
+    auto seconds = [](const std::tm &tm) {
+        return days_from_civil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday) * 86400 +
+               tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+    };
+    return seconds(local) - seconds(utc);
+}
+
+/**
+ * @brief Parses a log line of the form
+ * `2024-01-02T03:04:05.678901 tid1234 [IFO,Core] message`.
+ *
+ * MMCore writes local time; it is converted to seconds since the epoch with
+ * the UTC offset in force at that time (ambiguous only in the hour repeated
+ * when daylight saving time ends).
+ *
+ * @return the length of the header up to the message, or 0 if the line does
+ * not start with one (it is then a continuation of the previous entry's
+ * message, indented by MMCore to line up with it).
+ */
+size_t parse_log_line(const std::string &line, LogRecord &record) {
+    static const std::map<std::string, int> levels = {
+        {"trc", mmcore::LogLevelTrace},   {"dbg", mmcore::LogLevelDebug},
+        {"IFO", mmcore::LogLevelInfo},    {"WRN", mmcore::LogLevelWarning},
+        {"ERR", mmcore::LogLevelError},   {"CRT", mmcore::LogLevelCritical}};
+
+    int year, month, day, hour, minute, second, fracStart = 0;
+    if (std::sscanf(line.c_str(), "%4d-%2d-%2dT%2d:%2d:%2d%n", &year, &month, &day, &hour,
+                    &minute, &second, &fracStart) != 6 ||
+        month < 1 || month > 12 || day < 1 || day > 31)
+        return 0;
+    size_t pos = static_cast<size_t>(fracStart);
+    double fraction = 0.0;
+    if (pos < line.size() && line[pos] == '.') {
+        size_t end = line.find(' ', pos);
+        fraction = std::strtod(line.substr(pos, end - pos).c_str(), nullptr);
+        pos = end;
+    }
+    if (pos == std::string::npos || line.compare(pos, 4, " tid") != 0)
+        return 0;
+    size_t bracket = line.find(" [", pos + 4);
+    size_t comma = line.find(',', bracket);
+    size_t close = line.find("] ", comma);
+    if (bracket == std::string::npos || comma == std::string::npos ||
+        close == std::string::npos)
+        return 0;
+    auto level = levels.find(line.substr(bracket + 2, comma - bracket - 2));
+    if (level == levels.end())
+        return 0;
+
+    int64_t local = days_from_civil(year, static_cast<unsigned>(month),
+                                    static_cast<unsigned>(day)) * 86400 +
+                    hour * 3600 + minute * 60 + second;
+    // Guess with the current offset, then use the offset at the guess, so
+    // entries from before a daylight saving switch are converted correctly.
+    int64_t utc = local - utc_offset(std::time(nullptr));
+    utc = local - utc_offset(static_cast<std::time_t>(utc));
+    record.time = static_cast<double>(utc) + fraction;
+    const char *tid = line.c_str() + pos + 4;
+    bool hex = tid[0] == '0' && (tid[1] == 'x' || tid[1] == 'X');
+    record.thread = std::strtoull(tid, nullptr, hex ? 16 : 10);
+    record.level = level->second;
+    record.logger = line.substr(comma + 1, close - comma - 1);
+    record.message = line.substr(close + 2);
+    return close + 2;
+}
+
+/**
+ * @brief Collects MMCore's log output, including messages from the core and
+ * from device adapters, into a bounded in-memory buffer of structured records.
+ *
+ * MMCore has no public API for custom log sinks, so this registers a
+ * secondary log file in the temporary directory, and a background thread
+ * parses the lines appended to it every 100 ms (and `drain` on demand).  Only
+ * complete lines are parsed.  Once the file exceeds `ROTATE_BYTES`, logging
+ * moves to a new file; entries written to both files while they overlap are
+ * recognized and skipped in the new one.  Once `capacity` records are
+ * buffered, the oldest are dropped.
+ */
+class LogSink {
+  public:
+    static constexpr std::streamoff ROTATE_BYTES = 16 << 20;
+
+    LogSink(CMMCore &core, size_t capacity, bool enableDebug)
+        : core_(core), capacity_(capacity), enableDebug_(enableDebug) {
+        if (capacity == 0)
+            throw std::invalid_argument("capacity must be greater than 0");
+        open(file_);
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~LogSink() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopRequested_ = true;
+        }
+        wake_.notify_all();
+        thread_.join();
+        close(file_);
+    }
+
+    // Whether debug messages are written to the sink's file.
+    bool debug() const { return enableDebug_; }
+
+    // Parses what MMCore has written so far, then removes and returns up to
+    // `maxRecords` (0 = all) of the oldest records.
+    std::vector<LogRecord> drain(size_t maxRecords, size_t &dropped) {
+        {
+            std::lock_guard<std::mutex> fileLock(fileMutex_);
+            read(file_);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t n = maxRecords == 0 ? records_.size() : std::min(maxRecords, records_.size());
+        std::vector<LogRecord> out(std::make_move_iterator(records_.begin()),
+                                   std::make_move_iterator(records_.begin() + n));
+        records_.erase(records_.begin(), records_.begin() + n);
+        dropped = dropped_;
+        dropped_ = 0;
+        return out;
+    }
+
+  private:
+    struct LogFile {
+        std::string path;
+        int handle = -1;
+        std::ifstream stream;
+        std::streamoff offset = 0;
+        std::string partial; // an incomplete last line
+    };
+
+    void open(LogFile &file) {
+        static std::atomic<unsigned> counter{0};
+        auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        file.path = (std::filesystem::temp_directory_path() /
+                     ("pymmcore-nano-log-" + std::to_string(stamp) + "-" +
+                      std::to_string(counter++) + ".txt"))
+                        .string();
+        file.handle = core_.startSecondaryLogFile(file.path.c_str(), enableDebug_, true, false);
+    }
+
+    void close(LogFile &file) {
+        try {
+            if (file.handle >= 0)
+                core_.stopSecondaryLogFile(file.handle);
+        } catch (...) {
+        }
+        file.stream.close();
+        std::error_code ec;
+        std::filesystem::remove(file.path, ec);
+    }
+
+    // Parses the complete lines appended since the last call, adding the raw
+    // lines to `lines` if given.  Caller must hold fileMutex_.
+    void read(LogFile &file, std::vector<std::string> *lines = nullptr) {
+        if (!file.stream.is_open())
+            file.stream.open(file.path, std::ios::binary); // MMCore may not have created it yet
+        if (!file.stream.is_open())
+            return;
+        file.stream.clear();
+        file.stream.seekg(0, std::ios::end);
+        std::streamoff end = file.stream.tellg();
+        if (end <= file.offset)
+            return;
+        std::string chunk(static_cast<size_t>(end - file.offset), '\0');
+        file.stream.seekg(file.offset);
+        file.stream.read(&chunk[0], static_cast<std::streamsize>(chunk.size()));
+        chunk.resize(static_cast<size_t>(file.stream.gcount()));
+        file.offset += static_cast<std::streamoff>(chunk.size());
+        size_t start = 0;
+        for (size_t nl; (nl = chunk.find('\n', start)) != std::string::npos; start = nl + 1) {
+            file.partial.append(chunk, start, nl - start);
+            parse(file.partial, lines);
+            file.partial.clear();
+        }
+        file.partial.append(chunk, start, std::string::npos);
+    }
+
+    // Starts a new file, then stops the old one and reads it to the end.
+    // Entries logged in between went to both; they are a run of lines from
+    // the end of the old file, skipped at the start of the new one.
+    // Caller must hold fileMutex_.
+    void rotate() {
+        LogFile next;
+        open(next);
+        try {
+            core_.stopSecondaryLogFile(file_.handle);
+        } catch (...) {
+        }
+        file_.handle = -1;
+        std::vector<std::string> tail;
+        read(file_, &tail);
+        if (!file_.partial.empty())
+            parse(file_.partial, &tail);
+        close(file_);
+        file_ = std::move(next);
+        overlap_.clear();
+        overlap_.insert(tail.begin(), tail.end());
+    }
+
+    void parse(std::string line, std::vector<std::string> *lines) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (!overlap_.empty()) {
+            auto it = overlap_.find(line);
+            if (it != overlap_.end()) {
+                overlap_.erase(it); // already read from the previous file
+                return;
+            }
+            overlap_.clear();
+        }
+        if (lines)
+            lines->push_back(line);
+        LogRecord record;
+        size_t header = parse_log_line(line, record);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (header == 0) {
+            size_t indent = std::min(line.find_first_not_of(' '), headerLength_);
+            if (!records_.empty())
+                records_.back().message += "\n" + line.substr(std::min(indent, line.size()));
+            return;
+        }
+        headerLength_ = header;
+        if (records_.size() == capacity_) {
+            records_.pop_front();
+            ++dropped_;
+        }
+        records_.push_back(std::move(record));
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopRequested_) {
+            lock.unlock();
+            {
+                std::lock_guard<std::mutex> fileLock(fileMutex_);
+                try {
+                    read(file_);
+                    if (file_.offset > ROTATE_BYTES)
+                        rotate();
+                } catch (...) {
+                    // keep what was read; try again on the next round
+                }
+            }
+            lock.lock();
+            wake_.wait_for(lock, std::chrono::milliseconds(100),
+                           [this] { return stopRequested_; });
+        }
+    }
+
+    CMMCore &core_;
+    size_t capacity_;
+    bool enableDebug_;
+    std::mutex fileMutex_; // guards file_ and overlap_
+    LogFile file_;
+    std::unordered_multiset<std::string> overlap_;
+    std::mutex mutex_; // guards the records and stopRequested_
+    std::condition_variable wake_;
+    std::deque<LogRecord> records_;
+    size_t dropped_ = 0;
+    size_t headerLength_ = 0; // of the last entry, to strip continuation indents
+    bool stopRequested_ = false;
+    std::thread thread_;
+};
+
+///////////////// Shared-memory frame transport ///////////////////
+
+/*
+ * Layout of a shared frame ring: a ShmRingHeader, then `slotCount` slots of
+ * `slotStride` bytes, each a ShmSlotHeader followed by the pixel data.
+ *
+ * Slots are written with a sequence lock: frame n goes into slot n % slotCount,
+ * whose `seq` is 2n+1 while it is written and 2n+2 once complete.  `published`
+ * is the number of complete frames.  Readers never write to the segment.
+ *
+ * A segment is only replaced if its publisher is gone: it has set `closed`, or
+ * the process `ownerPid` no longer exists (it crashed).
+ */
+constexpr uint64_t SHM_RING_MAGIC = 0x676e6952656d7246ULL; // "FrmRing"
+constexpr uint32_t SHM_RING_VERSION = 2;
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shared frame rings need lock-free 64-bit atomics");
+
+struct ShmRingHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint64_t slotBytes;  // pixel capacity of each slot
+    uint64_t slotStride; // distance between slots
+    int64_t ownerPid;    // process of the publisher
+    alignas(64) std::atomic<uint64_t> published;
+    std::atomic<uint64_t> closed; // nonzero once the publisher is gone
+};
+
+struct alignas(64) ShmSlotHeader {
+    std::atomic<uint64_t> seq;
+    uint32_t width, height, bytesPerPixel, numComponents;
+    uint64_t nbytes;
+    double timestamp; // seconds since the epoch
+};
+
+constexpr size_t SHM_SLOT_DATA_OFFSET = sizeof(ShmSlotHeader);
+
+std::string shm_name(std::string name) {
+    if (name.empty())
+        throw std::invalid_argument("Shared memory name must not be empty");
+    return name[0] == '/' ? name : "/" + name;
+}
+
+#ifndef _WIN32
+// Whether the existing segment `name` is a frame ring whose publisher is gone.
+bool stale_shm_ring(const std::string &name) {
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        return errno == ENOENT; // removed meanwhile
+    bool stale = false;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(ShmRingHeader)) {
+        void *base = ::mmap(nullptr, sizeof(ShmRingHeader), PROT_READ, MAP_SHARED, fd, 0);
+        if (base != MAP_FAILED) {
+            const auto *header = static_cast<const ShmRingHeader *>(base);
+            if (header->magic == SHM_RING_MAGIC) {
+                bool ownerGone = header->version == SHM_RING_VERSION && header->ownerPid > 0 &&
+                                 ::kill(static_cast<pid_t>(header->ownerPid), 0) != 0 &&
+                                 errno == ESRCH;
+                stale = ownerGone || header->closed.load(std::memory_order_acquire) != 0;
+            }
+            ::munmap(base, sizeof(ShmRingHeader));
+        }
+    }
+    ::close(fd);
+    return stale;
+}
+#endif
+
+/**
+ * @brief Publishes frames from the circular buffer into a named POSIX shared
+ * memory ring, from which SharedFrameReader instances in other processes read.
+ *
+ * A background thread pops every frame from the circular buffer (it must be
+ * the only consumer) and copies it into the ring, without touching Python.
+ */
+class SharedFramePublisher {
+  public:
+    SharedFramePublisher(CMMCore &core, std::string name, uint32_t slotCount,
+                         uint64_t slotBytes)
+        : core_(core), name_(shm_name(std::move(name))) {
+        if (slotCount == 0)
+            throw std::invalid_argument("slotCount must be greater than 0");
+        if (slotBytes == 0)
+            slotBytes = static_cast<uint64_t>(core.getImageBufferSize());
+        if (slotBytes == 0)
+            throw std::invalid_argument("No camera image size available; pass slotBytes");
+#ifdef _WIN32
+        throw std::runtime_error("Shared frame rings require POSIX shared memory and are not "
+                                 "supported on Windows");
+#else
+        uint64_t stride = (SHM_SLOT_DATA_OFFSET + slotBytes + 63) / 64 * 64;
+        size_ = sizeof(ShmRingHeader) + stride * slotCount;
+        int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        int err = errno;
+        if (fd < 0 && err == EEXIST) {
+            if (!stale_shm_ring(name_))
+                throw std::runtime_error("Shared memory " + name_ +
+                                         " already exists and its publisher is still running "
+                                         "(or it is not a shared frame ring)");
+            ::shm_unlink(name_.c_str()); // left behind by a publisher that crashed
+            fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            err = errno;
+        }
+        if (fd < 0)
+            throw std::runtime_error("Cannot create shared memory " + name_ + ": " +
+                                     std::strerror(err));
+        if (::ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+            int err = errno;
+            ::close(fd);
+            ::shm_unlink(name_.c_str());
+            throw std::runtime_error("Cannot size shared memory " + name_ + ": " +
+                                     std::strerror(err));
+        }
+        void *base = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            ::shm_unlink(name_.c_str());
+            throw std::runtime_error("Cannot map shared memory " + name_ + ": " +
+                                     std::strerror(errno));
+        }
+        base_ = static_cast<uint8_t *>(base);
+        // ftruncate zero-fills, so all slot sequences start at 0 (empty).
+        header_ = new (base_) ShmRingHeader{SHM_RING_MAGIC, SHM_RING_VERSION, slotCount,
+                                            slotBytes, stride, ::getpid(), {0}, {0}};
+#endif
+    }
+
+    ~SharedFramePublisher() {
+        stop();
+#ifndef _WIN32
+        if (base_) {
+            // Unlink first: once `closed` is set, a new publisher may replace the name.
+            ::shm_unlink(name_.c_str());
+            header_->closed.store(1, std::memory_order_release);
+            ::munmap(base_, size_);
+        }
+#endif
+    }
+
+    void start() {
+        std::lock_guard<std::mutex> threadLock(threadMutex_);
+        stopThread();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            lastError_.clear();
+        }
+        stopRequested_ = false;
+        running_ = true; // set before the thread exists, so isRunning() is true on return
+        thread_ = std::thread([this] { run(); });
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> threadLock(threadMutex_);
+        stopThread();
+    }
+
+    bool isRunning() const { return running_; }
+    const std::string &name() const { return name_; }
+    uint32_t slotCount() const { return header_->slotCount; }
+    uint64_t slotBytes() const { return header_->slotBytes; }
+    uint64_t framesPublished() const {
+        return header_->published.load(std::memory_order_acquire);
+    }
+
+    std::string lastError() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lastError_;
+    }
+
+  private:
+    // Caller must hold threadMutex_.
+    void stopThread() {
+        stopRequested_ = true;
+        if (thread_.joinable())
+            thread_.join();
+    }
+
+    void run() {
+        try {
+            while (!stopRequested_) {
+                if (core_.getRemainingImageCount() == 0) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                    continue;
+                }
+                Metadata md;
+                void *pixels = core_.popNextImageMD(md);
+                publish(pixels, metadata_image_geometry(core_, md));
+            }
+        } catch (const std::exception &e) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            lastError_ = e.what();
+        }
+        running_ = false;
+    }
+
+    void publish(const void *pixels, const ImageGeometry &g) {
+        uint64_t nbytes =
+            static_cast<uint64_t>(g.width) * g.height * g.bytesPerPixel;
+        if (nbytes > header_->slotBytes)
+            throw std::runtime_error("Frame of " + std::to_string(nbytes) +
+                                     " bytes does not fit the shared memory slots (" +
+                                     std::to_string(header_->slotBytes) + " bytes)");
+        uint64_t n = header_->published.load(std::memory_order_relaxed);
+        auto *slot = reinterpret_cast<ShmSlotHeader *>(
+            base_ + sizeof(ShmRingHeader) + (n % header_->slotCount) * header_->slotStride);
+        slot->seq.store(2 * n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(reinterpret_cast<uint8_t *>(slot) + SHM_SLOT_DATA_OFFSET, pixels, nbytes);
+        slot->width = g.width;
+        slot->height = g.height;
+        slot->bytesPerPixel = g.bytesPerPixel;
+        slot->numComponents = g.numComponents;
+        slot->nbytes = nbytes;
+        slot->timestamp = std::chrono::duration<double>(
+                              std::chrono::system_clock::now().time_since_epoch())
+                              .count();
+        slot->seq.store(2 * n + 2, std::memory_order_release);
+        header_->published.store(n + 1, std::memory_order_release);
+    }
+
+    CMMCore &core_;
+    std::string name_;
+    uint8_t *base_ = nullptr;
+    size_t size_ = 0;
+    ShmRingHeader *header_ = nullptr;
+    std::atomic<bool> stopRequested_{true};
+    std::atomic<bool> running_{false};
+    mutable std::mutex mutex_;
+    std::string lastError_;
+    std::mutex threadMutex_; // held for the whole of start() and stop()
+    std::thread thread_;
+};
+
+/**
+ * @brief Reads frames from a SharedFramePublisher's ring, possibly in another
+ * process, as zero-copy views of the shared memory.
+ *
+ * A view stays readable as long as it exists, but its contents are replaced
+ * once the publisher wraps around the ring; `isValid(frameNumber)` tells
+ * whether that has happened.
+ */
+class SharedFrameReader {
+  public:
+    struct Frame {
+        uint64_t number;
+        const ShmSlotHeader *slot;
+        ImageGeometry geometry;
+        double timestamp;
+    };
+
+    explicit SharedFrameReader(std::string name) : name_(shm_name(std::move(name))) {
+#ifdef _WIN32
+        throw std::runtime_error("Shared frame rings require POSIX shared memory and are not "
+                                 "supported on Windows");
+#else
+        int fd = ::shm_open(name_.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+            throw std::runtime_error("Cannot open shared memory " + name_ + ": " +
+                                     std::strerror(errno));
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmRingHeader)) {
+            ::close(fd);
+            throw std::runtime_error(name_ + " is not a shared frame ring");
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        void *base = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED)
+            throw std::runtime_error("Cannot map shared memory " + name_ + ": " +
+                                     std::strerror(errno));
+        base_ = static_cast<const uint8_t *>(base);
+        header_ = reinterpret_cast<const ShmRingHeader *>(base_);
+        if (header_->magic != SHM_RING_MAGIC || header_->version != SHM_RING_VERSION ||
+            sizeof(ShmRingHeader) + header_->slotStride * header_->slotCount > size_) {
+            ::munmap(const_cast<uint8_t *>(base_), size_);
+            throw std::runtime_error(name_ + " is not a compatible shared frame ring");
+        }
+        // Start with the frames published from now on.
+        cursor_ = header_->published.load(std::memory_order_acquire);
+#endif
+    }
+
+    ~SharedFrameReader() {
+#ifndef _WIN32
+        if (base_)
+            ::munmap(const_cast<uint8_t *>(base_), size_);
+#endif
+    }
+
+    // Waits for the next unread frame; negative timeout waits indefinitely.
+    std::optional<Frame> next(double timeout_ms) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto deadline = deadline_after(std::max(timeout_ms, 0.0));
+        for (;;) {
+            uint64_t published = framesPublished();
+            if (cursor_ < published) {
+                if (published - cursor_ > header_->slotCount) {
+                    dropped_ += published - header_->slotCount - cursor_;
+                    cursor_ = published - header_->slotCount;
+                }
+                Frame frame;
+                bool ok = read(cursor_, frame);
+                ++cursor_;
+                if (ok)
+                    return frame;
+                ++dropped_; // overwritten while we looked at it
+                continue;
+            }
+            if (header_->closed.load(std::memory_order_acquire) ||
+                (timeout_ms >= 0 && std::chrono::steady_clock::now() >= deadline))
+                return std::nullopt;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    // The most recent complete frame; does not move the read position.
+    std::optional<Frame> latest() const {
+        Frame frame;
+        for (int attempt = 0; attempt < 3; ++attempt) {
+            uint64_t published = framesPublished();
+            if (published == 0)
+                return std::nullopt;
+            if (read(published - 1, frame))
+                return frame;
+        }
+        return std::nullopt;
+    }
+
+    bool isValid(uint64_t number) const {
+        return slotFor(number)->seq.load(std::memory_order_acquire) == 2 * number + 2;
+    }
+
+    uint64_t framesPublished() const {
+        return header_->published.load(std::memory_order_acquire);
+    }
+    bool publisherClosed() const { return header_->closed.load(std::memory_order_acquire); }
+    uint64_t dropped() const { return dropped_; }
+    uint32_t slotCount() const { return header_->slotCount; }
+    const std::string &name() const { return name_; }
+
+  private:
+    const ShmSlotHeader *slotFor(uint64_t number) const {
+        return reinterpret_cast<const ShmSlotHeader *>(
+            base_ + sizeof(ShmRingHeader) + (number % header_->slotCount) * header_->slotStride);
+    }
+
+    bool read(uint64_t number, Frame &frame) const {
+        const ShmSlotHeader *slot = slotFor(number);
+        uint64_t seq = slot->seq.load(std::memory_order_acquire);
+        if (seq != 2 * number + 2)
+            return false;
+        frame = {number, slot,
+                 {slot->width, slot->height, slot->bytesPerPixel, slot->numComponents},
+                 slot->timestamp};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) != seq ||
+            static_cast<uint64_t>(frame.geometry.width) * frame.geometry.height *
+                    frame.geometry.bytesPerPixel >
+                header_->slotBytes)
+            return false;
+        return true;
+    }
+
+    std::string name_;
+    const uint8_t *base_ = nullptr;
+    size_t size_ = 0;
+    const ShmRingHeader *header_ = nullptr;
+    std::mutex mutex_; // guards the read position across threads
+    uint64_t cursor_ = 0;
+    std::atomic<uint64_t> dropped_{0};
+};
+
+nb::dlpack::dtype pixel_dtype(unsigned bytes) {
+    switch (bytes) {
+    case 1: return nb::dtype<uint8_t>();
+    case 2: return nb::dtype<uint16_t>();
+    case 4: return nb::dtype<uint32_t>();
+    default: throw std::invalid_argument("Unsupported element size");
+    }
+}
+
+// Zero-copy view of a shared frame, shaped like create_image_array's result.
+// `owner` keeps the mapping alive.  Must be called with the GIL held.
+np_array shared_frame_view(const SharedFrameReader::Frame &frame, nb::handle owner) {
+    const ImageGeometry &g = frame.geometry;
+    auto *data = const_cast<uint8_t *>(reinterpret_cast<const uint8_t *>(frame.slot) +
+                                       SHM_SLOT_DATA_OFFSET);
+    if (g.numComponents == 4) {
+        // BGRA pixels; view as RGB (see build_rgb_np_array).
+        unsigned channelBytes = g.bytesPerPixel / 4;
+        return np_array(data + 2 * channelBytes, {g.height, g.width, 3}, owner,
+                        {int64_t(g.width) * 4, 4, -1}, pixel_dtype(channelBytes));
+    }
+    return np_array(data, {g.height, g.width}, owner, {int64_t(g.width), 1},
+                    pixel_dtype(g.bytesPerPixel));
+}
+
+///////////////// Frame compression ///////////////////
+
+/*
+ * Lossless frame codec: pixels are byte-shuffled into planes (all low bytes,
+ * then all high bytes, ...), then compressed as a single LZ4 block with the
+ * reference LZ4 library (so any LZ4 implementation can decode the payload).
+ *
+ * For 2-byte pixels with a bit depth between 9 and 15, the high-byte plane is
+ * additionally bit-packed to `bitDepth - 8` bits per pixel (e.g. 4 bits for
+ * 12-bit cameras), unless a pixel exceeds the bit depth, so the codec stays
+ * lossless whatever the camera reports.
+ *
+ * A chunk is a FrameChunkHeader followed by the payload.
+ */
+constexpr char FRAME_CHUNK_MAGIC[4] = {'P', 'M', 'N', 'Z'};
+constexpr uint8_t FRAME_CHUNK_VERSION = 1;
+
+enum FrameCodec : uint8_t { CODEC_RAW = 0, CODEC_LZ4 = 1 };
+
+#pragma pack(push, 1)
+struct FrameChunkHeader {
+    char magic[4];
+    uint8_t version;
+    uint8_t codec;        // FrameCodec
+    uint8_t shuffled;     // 1 if bytes are split into planes
+    uint8_t highBits;     // bits per pixel of the packed high plane, 0 if not packed
+    uint32_t width, height, bytesPerPixel, numComponents, bitDepth;
+    uint64_t rawSize;     // size of the (shuffled) data before LZ4
+    uint64_t payloadSize; // bytes following this header
+};
+#pragma pack(pop)
+static_assert(sizeof(FrameChunkHeader) == 44, "FrameChunkHeader must be packed");
+
+// Compresses `n` bytes into one LZ4 block.
+std::vector<uint8_t> lz4_compress(const uint8_t *src, size_t n) {
+    if (n > LZ4_MAX_INPUT_SIZE)
+        throw std::invalid_argument("Frame is too large to compress");
+    std::vector<uint8_t> out(static_cast<size_t>(LZ4_compressBound(static_cast<int>(n))));
+    int size = LZ4_compress_default(reinterpret_cast<const char *>(src),
+                                    reinterpret_cast<char *>(out.data()), static_cast<int>(n),
+                                    static_cast<int>(out.size()));
+    if (size <= 0)
+        throw std::runtime_error("LZ4 compression failed");
+    out.resize(static_cast<size_t>(size));
+    return out;
+}
+
+// Decodes one LZ4 block that must expand to exactly `dstSize` bytes.
+void lz4_decompress(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize) {
+    constexpr size_t maxSize = static_cast<size_t>(std::numeric_limits<int>::max());
+    if (srcSize > maxSize || dstSize > maxSize ||
+        LZ4_decompress_safe(reinterpret_cast<const char *>(src), reinterpret_cast<char *>(dst),
+                            static_cast<int>(srcSize),
+                            static_cast<int>(dstSize)) != static_cast<int>(dstSize))
+        throw std::invalid_argument("Corrupt LZ4 data in frame chunk");
+}
+
+// Packs `values` (each < 2^bits) into a little-endian bit stream.
+void pack_bits(const uint8_t *values, size_t n, unsigned bits, uint8_t *out) {
+    uint32_t acc = 0;
+    unsigned filled = 0;
+    for (size_t i = 0; i < n; ++i) {
+        acc |= uint32_t(values[i]) << filled;
+        filled += bits;
+        while (filled >= 8) {
+            *out++ = static_cast<uint8_t>(acc);
+            acc >>= 8;
+            filled -= 8;
+        }
+    }
+    if (filled)
+        *out = static_cast<uint8_t>(acc);
+}
+
+void unpack_bits(const uint8_t *in, size_t n, unsigned bits, uint8_t *values) {
+    uint32_t acc = 0, mask = (1u << bits) - 1;
+    unsigned filled = 0;
+    for (size_t i = 0; i < n; ++i) {
+        while (filled < bits) {
+            acc |= uint32_t(*in++) << filled;
+            filled += 8;
+        }
+        values[i] = static_cast<uint8_t>(acc & mask);
+        acc >>= bits;
+        filled -= bits;
+    }
+}
+
+inline size_t packed_size(size_t n, unsigned bits) { return (n * bits + 7) / 8; }
+
+/**
+ * @brief Encodes one frame as a self-describing chunk (header + payload).
+ *
+ * `bitDepth` 0 means the full pixel width.
+ */
+std::vector<uint8_t> compress_frame(const uint8_t *pixels, const ImageGeometry &g,
+                                    unsigned bitDepth, bool shuffle) {
+    const size_t B = g.bytesPerPixel;
+    const size_t nPixels = size_t(g.width) * g.height;
+    const size_t nbytes = nPixels * B;
+    FrameChunkHeader header{};
+    std::memcpy(header.magic, FRAME_CHUNK_MAGIC, 4);
+    header.version = FRAME_CHUNK_VERSION;
+    header.width = g.width;
+    header.height = g.height;
+    header.bytesPerPixel = g.bytesPerPixel;
+    header.numComponents = g.numComponents;
+    header.bitDepth = bitDepth;
+
+    std::vector<uint8_t> planes;
+    const uint8_t *data = pixels;
+    size_t dataSize = nbytes;
+    if (shuffle && B > 1) {
+        header.shuffled = 1;
+        planes.resize(nbytes);
+        for (size_t i = 0; i < nPixels; ++i)
+            for (size_t b = 0; b < B; ++b)
+                planes[b * nPixels + i] = pixels[i * B + b];
+        if (B == 2 && bitDepth > 8 && bitDepth < 16) {
+            unsigned bits = bitDepth - 8;
+            const uint8_t *high = planes.data() + nPixels;
+            bool fits = std::all_of(high, high + nPixels,
+                                    [bits](uint8_t v) { return (v >> bits) == 0; });
+            if (fits) {
+                header.highBits = static_cast<uint8_t>(bits);
+                std::vector<uint8_t> packed(nPixels + packed_size(nPixels, bits));
+                std::memcpy(packed.data(), planes.data(), nPixels);
+                pack_bits(high, nPixels, bits, packed.data() + nPixels);
+                planes = std::move(packed);
+            }
+        }
+        data = planes.data();
+        dataSize = planes.size();
+    }
+    header.rawSize = dataSize;
+
+    std::vector<uint8_t> payload = lz4_compress(data, dataSize);
+    std::vector<uint8_t> chunk(sizeof(FrameChunkHeader));
+    if (payload.size() < dataSize) {
+        header.codec = CODEC_LZ4;
+        chunk.insert(chunk.end(), payload.begin(), payload.end());
+    } else {
+        header.codec = CODEC_RAW; // incompressible; store as is
+        chunk.insert(chunk.end(), data, data + dataSize);
+    }
+    header.payloadSize = chunk.size() - sizeof(FrameChunkHeader);
+    std::memcpy(chunk.data(), &header, sizeof(header));
+    return chunk;
+}
+
+// (bytesPerPixel, numComponents) pairs that decompressed_frame_array can
+// shape: gray 8/16/32-bit and BGRA with 8- or 16-bit channels.
+bool supported_pixel_format(uint32_t bytesPerPixel, uint32_t numComponents) {
+    if (numComponents == 1)
+        return bytesPerPixel == 1 || bytesPerPixel == 2 || bytesPerPixel == 4;
+    return numComponents == 4 && (bytesPerPixel == 4 || bytesPerPixel == 8);
+}
+
+// a * b, or throws if the product does not fit in size_t.
+size_t checked_size(size_t a, size_t b) {
+    if (a && b > std::numeric_limits<size_t>::max() / a)
+        throw std::invalid_argument("Frame chunk dimensions are too large");
+    return a * b;
+}
+
+/**
+ * @brief Decodes a chunk made by compress_frame back into pixel bytes.
+ *
+ * The header is validated before anything is allocated, so malformed or
+ * hostile chunks raise instead of reading or writing out of bounds.
+ */
+std::vector<uint8_t> decompress_frame(const uint8_t *chunk, size_t size,
+                                      FrameChunkHeader &header) {
+    if (size < sizeof(FrameChunkHeader))
+        throw std::invalid_argument("Frame chunk is too short");
+    std::memcpy(&header, chunk, sizeof(header));
+    if (std::memcmp(header.magic, FRAME_CHUNK_MAGIC, 4) != 0 ||
+        header.version != FRAME_CHUNK_VERSION)
+        throw std::invalid_argument("Not a compressed frame chunk");
+    if (header.payloadSize != size - sizeof(FrameChunkHeader))
+        throw std::invalid_argument("Frame chunk size does not match its header");
+    const size_t B = header.bytesPerPixel;
+    if (!supported_pixel_format(header.bytesPerPixel, header.numComponents))
+        throw std::invalid_argument("Unsupported pixel format in frame chunk header");
+    if (header.shuffled > 1 ||
+        (header.highBits && (!header.shuffled || B != 2 || header.highBits >= 8)))
+        throw std::invalid_argument("Inconsistent frame chunk header");
+    const size_t nPixels = checked_size(header.width, header.height);
+    const size_t nbytes = checked_size(nPixels, B);
+    const size_t expected =
+        header.highBits ? nPixels + packed_size(nPixels, header.highBits) : nbytes;
+    if (header.rawSize != expected)
+        throw std::invalid_argument("Inconsistent frame chunk header");
+    // Every LZ4 input byte expands to at most 255 output bytes; reject
+    // headers promising more before allocating for them.
+    if (header.codec == CODEC_LZ4 && header.rawSize / 255 > header.payloadSize)
+        throw std::invalid_argument("Corrupt LZ4 data in frame chunk");
+
+    const uint8_t *payload = chunk + sizeof(FrameChunkHeader);
+    std::vector<uint8_t> data(header.rawSize);
+    if (header.codec == CODEC_LZ4)
+        lz4_decompress(payload, header.payloadSize, data.data(), data.size());
+    else if (header.codec == CODEC_RAW && header.payloadSize == data.size())
+        std::memcpy(data.data(), payload, data.size());
+    else
+        throw std::invalid_argument("Unknown frame chunk codec");
+
+    if (!header.shuffled)
+        return data;
+    if (header.highBits) {
+        std::vector<uint8_t> planes(nPixels * 2);
+        std::memcpy(planes.data(), data.data(), nPixels);
+        unpack_bits(data.data() + nPixels, nPixels, header.highBits, planes.data() + nPixels);
+        data = std::move(planes);
+    }
+    std::vector<uint8_t> pixels(nbytes);
+    for (size_t i = 0; i < nPixels; ++i)
+        for (size_t b = 0; b < B; ++b)
+            pixels[i * B + b] = data[b * nPixels + i];
+    return pixels;
+}
+
+/**
+ * @brief Pops frames from the circular buffer and compresses them on a pool of
+ * worker threads, handing back chunks in acquisition order.
+ *
+ * Like SharedFramePublisher, it must be the only consumer of the circular
+ * buffer.  At most `maxPending` frames are held (queued, being compressed or
+ * waiting to be collected); beyond that, frames stay in the circular buffer.
+ */
+class FrameCompressor {
+  public:
+    struct Chunk {
+        uint64_t number;
+        std::vector<uint8_t> data;
+    };
+
+    FrameCompressor(CMMCore &core, unsigned threads, bool shuffle, size_t maxPending)
+        : core_(core), shuffle_(shuffle), maxPending_(maxPending) {
+        if (maxPending == 0)
+            throw std::invalid_argument("maxPending must be greater than 0");
+        threads_ = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    ~FrameCompressor() { stop(); }
+
+    void start() {
+        std::lock_guard<std::mutex> threadLock(threadMutex_);
+        stopWorkers();
+        std::lock_guard<std::mutex> lock(mutex_);
+        bitDepth_ = core_.getImageBitDepth();
+        stopRequested_ = false;
+        lastError_.clear();
+        queue_.clear();
+        done_.clear();
+        nextIn_ = nextOut_ = 0;
+        inFlight_ = 0;
+        workers_.emplace_back([this] { popLoop(); });
+        for (unsigned i = 0; i < threads_; ++i)
+            workers_.emplace_back([this] { compressLoop(); });
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> threadLock(threadMutex_);
+        stopWorkers();
+    }
+
+    // Waits for the next chunk in acquisition order; negative timeout waits
+    // indefinitely.  Returns nothing on timeout or once stopped and drained.
+    std::optional<Chunk> next(double timeout_ms) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto ready = [this] {
+            return done_.count(nextOut_) || (stopRequested_ && nextOut_ == nextIn_) ||
+                   !lastError_.empty();
+        };
+        if (timeout_ms < 0)
+            changed_.wait(lock, ready);
+        else
+            changed_.wait_until(lock, deadline_after(timeout_ms), ready);
+        auto it = done_.find(nextOut_);
+        if (it == done_.end())
+            return std::nullopt;
+        Chunk chunk{nextOut_++, std::move(it->second)};
+        done_.erase(it);
+        --inFlight_;
+        changed_.notify_all();
+        return chunk;
+    }
+
+    bool isRunning() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return !stopRequested_ && lastError_.empty();
+    }
+
+    std::string lastError() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lastError_;
+    }
+
+    uint64_t bytesIn() const { return bytesIn_; }
+    uint64_t bytesOut() const { return bytesOut_; }
+    unsigned threads() const { return threads_; }
+
+  private:
+    struct Task {
+        uint64_t number;
+        ImageGeometry geometry;
+        std::vector<uint8_t> pixels;
+    };
+
+    // Caller must hold threadMutex_.
+    void stopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopRequested_ = true;
+        }
+        changed_.notify_all();
+        for (auto &t : workers_)
+            t.join();
+        workers_.clear();
+    }
+
+    void fail(const std::string &what) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (lastError_.empty())
+            lastError_ = what;
+        stopRequested_ = true;
+        changed_.notify_all();
+    }
+
+    void popLoop() {
+        try {
+            for (;;) {
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    changed_.wait(lock, [this] { return stopRequested_ || inFlight_ < maxPending_; });
+                    if (stopRequested_)
+                        return;
+                }
+                if (core_.getRemainingImageCount() == 0) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                    continue;
+                }
+                Metadata md;
+                auto *pixels = static_cast<const uint8_t *>(core_.popNextImageMD(md));
+                ImageGeometry g = metadata_image_geometry(core_, md);
+                size_t nbytes = size_t(g.width) * g.height * g.bytesPerPixel;
+                Task task{0, g, std::vector<uint8_t>(pixels, pixels + nbytes)};
+                bytesIn_ += nbytes;
+                std::lock_guard<std::mutex> lock(mutex_);
+                task.number = nextIn_++;
+                ++inFlight_;
+                queue_.push_back(std::move(task));
+                changed_.notify_all();
+            }
+        } catch (const std::exception &e) {
+            fail(e.what());
+        }
+    }
+
+    void compressLoop() {
+        try {
+            for (;;) {
+                Task task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    changed_.wait(lock, [this] { return stopRequested_ || !queue_.empty(); });
+                    if (queue_.empty())
+                        return; // stopping, and everything queued is compressed
+                    task = std::move(queue_.front());
+                    queue_.pop_front();
+                }
+                std::vector<uint8_t> chunk =
+                    compress_frame(task.pixels.data(), task.geometry, bitDepth_, shuffle_);
+                bytesOut_ += chunk.size();
+                std::lock_guard<std::mutex> lock(mutex_);
+                done_.emplace(task.number, std::move(chunk));
+                changed_.notify_all();
+            }
+        } catch (const std::exception &e) {
+            fail(e.what());
+        }
+    }
+
+    CMMCore &core_;
+    const bool shuffle_;
+    const size_t maxPending_;
+    unsigned threads_;
+    unsigned bitDepth_ = 0;
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    bool stopRequested_ = true;
+    std::string lastError_;
+    std::deque<Task> queue_;
+    std::map<uint64_t, std::vector<uint8_t>> done_;
+    uint64_t nextIn_ = 0, nextOut_ = 0;
+    size_t inFlight_ = 0;
+    std::atomic<uint64_t> bytesIn_{0}, bytesOut_{0};
+    std::mutex threadMutex_; // held for the whole of start() and stop()
+    std::vector<std::thread> workers_;
+};
+
+// Decoded chunk as an array shaped like popNextImage()'s result.
+// Must be called with the GIL held.
+np_array decompressed_frame_array(std::vector<uint8_t> pixels, const FrameChunkHeader &h) {
+    if (!supported_pixel_format(h.bytesPerPixel, h.numComponents) ||
+        pixels.size() != checked_size(checked_size(h.width, h.height), h.bytesPerPixel))
+        throw std::invalid_argument("Decoded frame does not match its header");
+    auto *data = new std::vector<uint8_t>(std::move(pixels));
+    nb::capsule owner(data,
+                      [](void *p) noexcept { delete static_cast<std::vector<uint8_t> *>(p); });
+    if (h.numComponents == 4) {
+        // BGRA pixels; view as RGB (see build_rgb_np_array).
+        unsigned channelBytes = h.bytesPerPixel / 4;
+        return np_array(data->data() + 2 * channelBytes, {h.height, h.width, 3}, owner,
+                        {int64_t(h.width) * 4, 4, -1}, pixel_dtype(channelBytes));
+    }
+    return np_array(data->data(), {h.height, h.width}, owner, {int64_t(h.width), 1},
+                    pixel_dtype(h.bytesPerPixel));
+}
+
+///////////////// Frame accumulation ///////////////////
+
+enum class AccumulateMode { Sum, Mean, Max };
+
+AccumulateMode parse_accumulate_mode(const std::string &mode) {
+    if (mode == "sum")
+        return AccumulateMode::Sum;
+    if (mode == "mean")
+        return AccumulateMode::Mean;
+    if (mode == "max")
+        return AccumulateMode::Max;
+    throw std::invalid_argument("mode must be one of 'mean', 'sum' or 'max', not '" + mode + "'");
+}
+
+// The reduction kernels are plain loops over contiguous buffers so that the
+// compiler vectorizes them for whatever instruction set the wheel targets.
+template <typename Acc, typename Pix>
+void accumulate_add(Acc *acc, const Pix *pixels, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        acc[i] += pixels[i];
+}
+
+template <typename Pix> void accumulate_max(Pix *acc, const Pix *pixels, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        acc[i] = std::max(acc[i], pixels[i]);
+}
+
+/**
+ * @brief Pops the frames of a running sequence acquisition as they arrive.
+ *
+ * All frames must have the geometry of the first one.  Waiting fails if the
+ * sequence stops early (e.g. on buffer overflow) or no frame arrives within
+ * the exposure time plus the core timeout.
+ */
+class SequenceFrames {
+  public:
+    explicit SequenceFrames(CMMCore &core)
+        : core_(core), waitMs_(core.getExposure() + core.getTimeoutMs()) {}
+
+    const void *next() {
+        auto deadline = deadline_after(waitMs_);
+        for (;;) {
+            if (core_.getRemainingImageCount() > 0)
+                break;
+            if (!core_.isSequenceRunning() && core_.getRemainingImageCount() == 0)
+                throw std::runtime_error("Sequence acquisition stopped after " +
+                                         std::to_string(popped_) + " frames");
+            if (std::chrono::steady_clock::now() > deadline)
+                throw std::runtime_error("Timed out waiting for frame " +
+                                         std::to_string(popped_));
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        Metadata md;
+        const void *pixels = core_.popNextImageMD(md);
+        ImageGeometry g = metadata_image_geometry(core_, md);
+        if (popped_++ == 0)
+            geometry_ = g;
+        else if (g.width != geometry_.width || g.height != geometry_.height ||
+                 g.bytesPerPixel != geometry_.bytesPerPixel ||
+                 g.numComponents != geometry_.numComponents)
+            throw std::runtime_error("Frame size changed during accumulation");
+        return pixels;
+    }
+
+    // Waits for the camera to report the sequence finished after its last
+    // frame was popped, so that callers return with the camera idle.
+    void finish() {
+        auto deadline = deadline_after(waitMs_);
+        while (core_.isSequenceRunning()) {
+            if (std::chrono::steady_clock::now() > deadline)
+                throw std::runtime_error("Sequence acquisition still running after " +
+                                         std::to_string(popped_) + " frames");
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    const ImageGeometry &geometry() const { return geometry_; }
+
+    // Number of channel values in a frame.
+    size_t elementCount() const {
+        return size_t(geometry_.width) * geometry_.height * geometry_.numComponents;
+    }
+
+  private:
+    CMMCore &core_;
+    double waitMs_;
+    long popped_ = 0;
+    ImageGeometry geometry_{};
+};
+
+template <typename Pix, typename Acc>
+np_array sum_frames(SequenceFrames &frames, long n, const void *first, bool mean) {
+    size_t count = frames.elementCount();
+    std::vector<Acc> acc(count);
+    accumulate_add(acc.data(), static_cast<const Pix *>(first), count);
+    for (long i = 1; i < n; ++i)
+        accumulate_add(acc.data(), static_cast<const Pix *>(frames.next()), count);
+    if (!mean)
+        return owned_image(std::move(acc), frames.geometry());
+    std::vector<float> result(count);
+    double scale = 1.0 / n;
+    for (size_t i = 0; i < count; ++i)
+        result[i] = static_cast<float>(acc[i] * scale);
+    return owned_image(std::move(result), frames.geometry());
+}
+
+template <typename Pix>
+np_array reduce_frames(SequenceFrames &frames, long n, const void *first, AccumulateMode mode) {
+    if (mode == AccumulateMode::Max) {
+        size_t count = frames.elementCount();
+        auto *pixels = static_cast<const Pix *>(first);
+        std::vector<Pix> acc(pixels, pixels + count);
+        for (long i = 1; i < n; ++i)
+            accumulate_max(acc.data(), static_cast<const Pix *>(frames.next()), count);
+        return owned_image(std::move(acc), frames.geometry());
+    }
+    bool mean = mode == AccumulateMode::Mean;
+    // Sum into uint32 whenever n frames cannot overflow it.
+    uint64_t maxSum = uint64_t(std::numeric_limits<Pix>::max()) * uint64_t(n);
+    if (sizeof(Pix) < 4 && maxSum <= std::numeric_limits<uint32_t>::max())
+        return sum_frames<Pix, uint32_t>(frames, n, first, mean);
+    return sum_frames<Pix, uint64_t>(frames, n, first, mean);
+}
+
+/**
+ * @brief Acquires `n` frames with a sequence acquisition and reduces them as
+ * they arrive, so that only the result is ever copied out of the circular
+ * buffer.  Called with the GIL released.
+ */
+np_array acquire_accumulated(CMMCore &core, long n, AccumulateMode mode) {
+    if (n < 1)
+        throw std::invalid_argument("n must be at least 1");
+    core.startSequenceAcquisition(n, 0.0, true);
+    try {
+        SequenceFrames frames(core);
+        const void *first = frames.next();
+        const ImageGeometry &g = frames.geometry();
+        np_array result;
+        switch (g.bytesPerPixel / g.numComponents) {
+        case 1: result = reduce_frames<uint8_t>(frames, n, first, mode); break;
+        case 2: result = reduce_frames<uint16_t>(frames, n, first, mode); break;
+        case 4: result = reduce_frames<uint32_t>(frames, n, first, mode); break;
+        default: throw std::invalid_argument("Unsupported element size");
+        }
+        frames.finish();
+        return result;
+    } catch (...) {
+        try {
+            if (core.isSequenceRunning())
+                core.stopSequenceAcquisition();
+        } catch (...) {
+        }
+        throw;
+    }
+}
+
+///////////////// Software autofocus ///////////////////
+
+enum class FocusMetric { Brenner, Laplacian, Variance };
+
+FocusMetric parse_focus_metric(const std::string &metric) {
+    if (metric == "brenner")
+        return FocusMetric::Brenner;
+    if (metric == "laplacian")
+        return FocusMetric::Laplacian;
+    if (metric == "variance")
+        return FocusMetric::Variance;
+    throw std::invalid_argument("metric must be one of 'brenner', 'laplacian' or 'variance', not '" +
+                                metric + "'");
+}
+
+// Row sums are taken in int64 (double for 32-bit pixels, whose squares could
+// overflow) so the inner loops vectorize; only row totals are summed in double.
+template <typename Pix>
+double focus_score_of(const Pix *pixels, size_t width, size_t height, FocusMetric metric) {
+    using Acc = std::conditional_t<(sizeof(Pix) < 4), int64_t, double>;
+    double total = 0;
+    size_t terms = 0;
+    switch (metric) {
+    case FocusMetric::Brenner:
+        // Mean squared difference between pixels two columns apart.
+        if (width < 3)
+            break;
+        for (size_t y = 0; y < height; ++y) {
+            const Pix *row = pixels + y * width;
+            Acc sum = 0;
+            for (size_t x = 0; x + 2 < width; ++x) {
+                Acc d = Acc(row[x + 2]) - Acc(row[x]);
+                sum += d * d;
+            }
+            total += double(sum);
+        }
+        terms = (width - 2) * height;
+        break;
+    case FocusMetric::Laplacian:
+        // Mean squared response of the 4-neighbour Laplacian.
+        if (width < 3 || height < 3)
+            break;
+        for (size_t y = 1; y + 1 < height; ++y) {
+            const Pix *up = pixels + (y - 1) * width;
+            const Pix *row = up + width;
+            const Pix *down = row + width;
+            Acc sum = 0;
+            for (size_t x = 1; x + 1 < width; ++x) {
+                Acc l = Acc(up[x]) + Acc(down[x]) + Acc(row[x - 1]) + Acc(row[x + 1]) -
+                        4 * Acc(row[x]);
+                sum += l * l;
+            }
+            total += double(sum);
+        }
+        terms = (width - 2) * (height - 2);
+        break;
+    case FocusMetric::Variance: {
+        // Variance normalized by the mean intensity.
+        double sum = 0, sumSq = 0;
+        for (size_t y = 0; y < height; ++y) {
+            const Pix *row = pixels + y * width;
+            double rowSum = 0, rowSumSq = 0;
+            for (size_t x = 0; x < width; ++x) {
+                double v = row[x];
+                rowSum += v;
+                rowSumSq += v * v;
+            }
+            sum += rowSum;
+            sumSq += rowSumSq;
+        }
+        double n = double(width) * height;
+        double mean = n > 0 ? sum / n : 0;
+        return mean > 0 ? (sumSq / n - mean * mean) / mean : 0;
+    }
+    }
+    return terms > 0 ? total / double(terms) : 0;
+}
+
+double focus_score(const void *pixels, const ImageGeometry &g, FocusMetric metric) {
+    if (g.numComponents != 1)
+        throw std::invalid_argument("Focus metrics require grayscale images");
+    switch (g.bytesPerPixel) {
+    case 1: return focus_score_of(static_cast<const uint8_t *>(pixels), g.width, g.height, metric);
+    case 2: return focus_score_of(static_cast<const uint16_t *>(pixels), g.width, g.height, metric);
+    case 4: return focus_score_of(static_cast<const uint32_t *>(pixels), g.width, g.height, metric);
+    default: throw std::invalid_argument("Unsupported element size");
+    }
+}
+
+struct FocusSearch {
+    std::vector<double> positions;
+    std::vector<double> scores;
+    double bestPosition;
+    bool sequenced;
+};
+
+/**
+ * @brief Scores the image at each of `positions` of a focus stage and returns
+ * the position of the sharpest one.
+ *
+ * If the stage is sequenceable and `useSequence` is set, the positions are
+ * loaded as a stage sequence and imaged with one sequence acquisition
+ * (requires the camera to trigger the stage); otherwise the stage is stepped
+ * and an image snapped at each position.  Frames are scored straight from the
+ * core's buffers without copying.  The best position is refined by fitting a
+ * parabola through the peak and its neighbours.  Called with the GIL released.
+ */
+FocusSearch software_autofocus(CMMCore &core, std::vector<double> positions,
+                               FocusMetric metric, std::string stage, bool useSequence,
+                               bool moveToBest) {
+    if (positions.empty())
+        throw std::invalid_argument("positions must not be empty");
+    if (stage.empty())
+        stage = core.getFocusDevice();
+    if (stage.empty())
+        throw std::runtime_error("No focus stage given and no default focus device set");
+
+    FocusSearch result{positions, {}, positions.front(), false};
+    result.scores.reserve(positions.size());
+    long n = static_cast<long>(positions.size());
+    result.sequenced = useSequence && n > 1 && core.isStageSequenceable(stage.c_str()) &&
+                       n <= core.getStageSequenceMaxLength(stage.c_str());
+    if (result.sequenced) {
+        core.loadStageSequence(stage.c_str(), positions);
+        core.startStageSequence(stage.c_str());
+        try {
+            core.startSequenceAcquisition(n, 0.0, true);
+            SequenceFrames frames(core);
+            for (long i = 0; i < n; ++i) {
+                const void *pixels = frames.next();
+                result.scores.push_back(focus_score(pixels, frames.geometry(), metric));
+            }
+            frames.finish();
+        } catch (...) {
+            try {
+                if (core.isSequenceRunning())
+                    core.stopSequenceAcquisition();
+                core.stopStageSequence(stage.c_str());
+            } catch (...) {
+            }
+            throw;
+        }
+        core.stopStageSequence(stage.c_str());
+    } else {
+        ImageGeometry g{};
+        for (double z : positions) {
+            core.setPosition(stage.c_str(), z);
+            core.waitForDevice(stage.c_str());
+            core.snapImage();
+            if (result.scores.empty())
+                g = {core.getImageWidth(), core.getImageHeight(), core.getBytesPerPixel(),
+                     core.getNumberOfComponents()};
+            result.scores.push_back(focus_score(core.getImage(), g, metric));
+        }
+    }
+
+    size_t best = static_cast<size_t>(
+        std::max_element(result.scores.begin(), result.scores.end()) - result.scores.begin());
+    result.bestPosition = positions[best];
+    if (best > 0 && best + 1 < positions.size()) {
+        // Vertex of the parabola through the peak and its neighbours, in
+        // units of the (possibly uneven) step on either side.
+        double s0 = result.scores[best - 1], s1 = result.scores[best],
+               s2 = result.scores[best + 1];
+        double denom = s0 - 2 * s1 + s2;
+        if (denom < 0) {
+            double offset = 0.5 * (s0 - s2) / denom;
+            result.bestPosition +=
+                offset * (offset < 0 ? positions[best] - positions[best - 1]
+                                     : positions[best + 1] - positions[best]);
+        }
+    }
+    if (moveToBest) {
+        core.setPosition(stage.c_str(), result.bestPosition);
+        core.waitForDevice(stage.c_str());
+    }
+    return result;
+}
+
+///////////////// Circular buffer sizing and monitoring ///////////////////
+
+// Physical memory currently available to the process (total physical memory
+// on platforms that do not report free memory, e.g. macOS).  Defined at the
+// end of this file, the only place that includes <windows.h>.
+uint64_t available_memory_bytes();
+
+/**
+ * @brief Sizes the circular buffer to hold `bufferSeconds` of frames of the
+ * current camera at `frameRate` (default: 1 / exposure), capped at
+ * `maxMemoryFraction` of the available memory.  Returns the size in MB.
+ */
+unsigned auto_size_circular_buffer(CMMCore &core, double bufferSeconds, double frameRate,
+                                   double maxMemoryFraction) {
+    if (bufferSeconds <= 0)
+        throw std::invalid_argument("bufferSeconds must be positive");
+    if (maxMemoryFraction <= 0 || maxMemoryFraction > 1)
+        throw std::invalid_argument("maxMemoryFraction must be in (0, 1]");
+    if (frameRate <= 0)
+        frameRate = 1000.0 / std::max(core.getExposure(), 1e-3);
+    double frameBytes = double(core.getImageBufferSize()) *
+                        std::max(core.getNumberOfCameraChannels(), 1u);
+    double frames = std::max(std::ceil(frameRate * bufferSeconds), 2.0);
+    double bytes = frameBytes * frames;
+    if (uint64_t available = available_memory_bytes())
+        bytes = std::min(bytes, double(available) * maxMemoryFraction);
+    double mb = std::max(std::ceil(bytes / (1024.0 * 1024.0)), 1.0);
+    auto sizeMB = static_cast<unsigned>(
+        std::min(mb, double(std::numeric_limits<unsigned>::max())));
+    core.setCircularBufferMemoryFootprint(sizeMB);
+    return sizeMB;
+}
+
+/**
+ * @brief Samples the circular buffer fill level from a background thread,
+ * keeping high-water-mark and overflow statistics.
+ *
+ * It only observes the buffer: frames are never popped, so any number of
+ * consumers can read from it while it is monitored.
+ */
+class CircularBufferMonitor {
+  public:
+    struct Statistics {
+        long capacity = 0, occupancy = 0, highWaterMark = 0;
+        double meanOccupancy = 0;
+        uint64_t overflows = 0, samples = 0;
+    };
+
+    explicit CircularBufferMonitor(CMMCore &core) : core_(core) {}
+
+    ~CircularBufferMonitor() { stop(); }
+
+    void start(double intervalMs) {
+        if (intervalMs <= 0)
+            throw std::invalid_argument("intervalMs must be positive");
+        std::lock_guard<std::mutex> threadLock(threadMutex_);
+        stopThread();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopRequested_ = false;
+        }
+        auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(intervalMs));
+        thread_ = std::thread([this, interval] { run(interval); });
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> threadLock(threadMutex_);
+        stopThread();
     }
-}
 
-void validate_slm_image(const nb::ndarray<uint8_t> &pixels, long expectedWidth,
-                        long expectedHeight, long bytesPerPixel) {
-    // Check dtype
-    if (pixels.dtype() != nb::dtype<uint8_t>()) {
-        throw std::invalid_argument("Pixel array type is wrong. Expected uint8.");
+    bool isRunning() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return !stopRequested_;
     }
 
-    // Check dimensions
-    if (pixels.ndim() != 2 && pixels.ndim() != 3) {
-        throw std::invalid_argument(
-            "Pixels must be a 2D numpy array [h,w] of uint8, or a 3D numpy array "
-            "[h,w,c] of uint8 with 3 color channels [R,G,B].");
+    Statistics statistics() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Statistics s = stats_;
+        s.meanOccupancy = s.samples ? occupancySum_ / double(s.samples) : 0;
+        return s;
     }
 
-    // Check shape
-    if (pixels.shape(0) != expectedHeight || pixels.shape(1) != expectedWidth) {
-        throw std::invalid_argument("Image dimensions are wrong for this SLM. Expected (" +
-                                    std::to_string(expectedHeight) + ", " +
-                                    std::to_string(expectedWidth) + "), but received (" +
-                                    std::to_string(pixels.shape(0)) + ", " +
-                                    std::to_string(pixels.shape(1)) + ").");
+    void resetStatistics() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_ = Statistics{};
+        occupancySum_ = 0;
+    }
+
+  private:
+    // Caller must hold threadMutex_.
+    void stopThread() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopRequested_ = true;
+        }
+        wake_.notify_all();
+        if (thread_.joinable())
+            thread_.join();
     }
 
-    // Check total bytes
-    long expectedBytes = expectedWidth * expectedHeight * bytesPerPixel;
-    if (pixels.nbytes() != expectedBytes) {
-        throw std::invalid_argument("Image size is wrong for this SLM. Expected " +
-                                    std::to_string(expectedBytes) + " bytes, but received " +
-                                    std::to_string(pixels.nbytes()) +
-                                    " bytes. Does this SLM support RGB?");
+    void run(std::chrono::steady_clock::duration interval) {
+        auto next = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopRequested_) {
+            lock.unlock();
+            long capacity = 0, occupancy = 0;
+            bool overflowed = false, ok = true;
+            try {
+                capacity = core_.getBufferTotalCapacity();
+                occupancy = core_.getRemainingImageCount();
+                overflowed = core_.isBufferOverflowed();
+            } catch (const CMMError &) {
+                ok = false;
+            }
+            auto now = std::chrono::steady_clock::now();
+            lock.lock();
+            if (ok) {
+                stats_.capacity = capacity;
+                stats_.occupancy = occupancy;
+                stats_.highWaterMark = std::max(stats_.highWaterMark, occupancy);
+                if (overflowed && !wasOverflowed_)
+                    ++stats_.overflows;
+                wasOverflowed_ = overflowed;
+                occupancySum_ += double(occupancy);
+                ++stats_.samples;
+            }
+            next += interval;
+            if (next < now)
+                next = now; // fell behind; don't try to catch up with a burst
+            wake_.wait_until(lock, next, [this] { return stopRequested_; });
+        }
     }
 
-    // Ensure C-contiguous layout
-    // TODO
-}
+    CMMCore &core_;
+    Statistics stats_;
+    double occupancySum_ = 0;
+    bool wasOverflowed_ = false;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopRequested_ = true;
+    std::mutex threadMutex_; // held for the whole of start() and stop()
+    std::thread thread_;
+};
 
 ///////////////// Trampoline class for MMEventCallback ///////////////////
 
@@ -280,6 +3611,443 @@ class PyMMEventCallback : public MMEventCallback {
     }
 };
 
+///////////////// Event routing and property subscriptions ///////////////////
+
+/**
+ * @brief The MMEventCallback that the bindings register with CMMCore.
+ *
+ * Every event is forwarded to the user callback set with `registerCallback`
+ * (if any).  Property changes are additionally matched against the
+ * subscriptions made with `subscribeProperty`; the matching is done in C++
+ * and the GIL is only acquired when at least one subscription matches.
+ */
+class EventRouter : public MMEventCallback {
+  public:
+    // Matches any device label or property name in a subscription.
+    static constexpr const char *WILDCARD = "*";
+
+    void setDownstream(MMEventCallback *cb) { downstream_.store(cb); }
+
+    // Must be called with the GIL held.
+    size_t subscribe(std::string label, std::string prop, nb::object callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t id = ++lastId_;
+        subscriptions_.push_back({id, std::move(label), std::move(prop), std::move(callback)});
+        return id;
+    }
+
+    // Must be called with the GIL held.
+    bool unsubscribe(size_t id) {
+        nb::object callback; // released after unlocking; that may run Python code
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = subscriptions_.begin(); it != subscriptions_.end(); ++it) {
+            if (it->id == id) {
+                callback = std::move(it->callback);
+                subscriptions_.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Visits the subscribed callbacks for the garbage collector (tp_traverse).
+    int traverse(visitproc visit, void *arg) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &sub : subscriptions_)
+            Py_VISIT(sub.callback.ptr());
+        return 0;
+    }
+
+    // Drops all subscriptions (tp_clear).  Must be called with the GIL held.
+    void clear() {
+        std::vector<Subscription> subscriptions;
+        std::lock_guard<std::mutex> lock(mutex_);
+        subscriptions.swap(subscriptions_);
+    }
+
+    void onPropertiesChanged() override {
+        if (auto *cb = downstream_.load())
+            cb->onPropertiesChanged();
+    }
+
+    void onPropertyChanged(const char *name, const char *propName,
+                           const char *propValue) override {
+        if (auto *cb = downstream_.load())
+            cb->onPropertyChanged(name, propName, propValue);
+        dispatchPropertyChanged(name, propName, propValue);
+    }
+
+    void onChannelGroupChanged(const char *newChannelGroupName) override {
+        if (auto *cb = downstream_.load())
+            cb->onChannelGroupChanged(newChannelGroupName);
+    }
+
+    void onConfigGroupChanged(const char *groupName, const char *newConfigName) override {
+        if (auto *cb = downstream_.load())
+            cb->onConfigGroupChanged(groupName, newConfigName);
+    }
+
+    void onSystemConfigurationLoaded() override {
+        if (auto *cb = downstream_.load())
+            cb->onSystemConfigurationLoaded();
+    }
+
+    void onPixelSizeChanged(double newPixelSizeUm) override {
+        if (auto *cb = downstream_.load())
+            cb->onPixelSizeChanged(newPixelSizeUm);
+    }
+
+    void onPixelSizeAffineChanged(double v0, double v1, double v2, double v3, double v4,
+                                  double v5) override {
+        if (auto *cb = downstream_.load())
+            cb->onPixelSizeAffineChanged(v0, v1, v2, v3, v4, v5);
+    }
+
+    void onStagePositionChanged(const char *name, double pos) override {
+        if (auto *cb = downstream_.load())
+            cb->onStagePositionChanged(name, pos);
+    }
+
+    void onXYStagePositionChanged(const char *name, double xpos, double ypos) override {
+        if (auto *cb = downstream_.load())
+            cb->onXYStagePositionChanged(name, xpos, ypos);
+    }
+
+    void onExposureChanged(const char *name, double newExposure) override {
+        if (auto *cb = downstream_.load())
+            cb->onExposureChanged(name, newExposure);
+    }
+
+    void onShutterOpenChanged(const char *name, bool open) override {
+        if (auto *cb = downstream_.load())
+            cb->onShutterOpenChanged(name, open);
+    }
+
+    void onSLMExposureChanged(const char *name, double newExposure) override {
+        if (auto *cb = downstream_.load())
+            cb->onSLMExposureChanged(name, newExposure);
+    }
+
+    void onImageSnapped(const char *cameraLabel) override {
+        if (auto *cb = downstream_.load())
+            cb->onImageSnapped(cameraLabel);
+    }
+
+    void onSequenceAcquisitionStarted(const char *cameraLabel) override {
+        if (auto *cb = downstream_.load())
+            cb->onSequenceAcquisitionStarted(cameraLabel);
+    }
+
+    void onSequenceAcquisitionStopped(const char *cameraLabel) override {
+        if (auto *cb = downstream_.load())
+            cb->onSequenceAcquisitionStopped(cameraLabel);
+    }
+
+  private:
+    struct Subscription {
+        size_t id;
+        std::string label;
+        std::string prop;
+        nb::object callback;
+
+        bool matches(const char *l, const char *p) const {
+            return (label == WILDCARD || label == l) && (prop == WILDCARD || prop == p);
+        }
+    };
+
+    // Called from whichever thread MMCore emits the event on, usually without
+    // the GIL.  Lock order is always GIL -> mutex_, never the reverse.
+    void dispatchPropertyChanged(const char *label, const char *prop, const char *value) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            bool any = false;
+            for (const auto &sub : subscriptions_) {
+                if (sub.matches(label, prop)) {
+                    any = true;
+                    break;
+                }
+            }
+            if (!any)
+                return;
+        }
+
+        nb::gil_scoped_acquire gil;
+        std::vector<nb::object> targets;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto &sub : subscriptions_) {
+                if (sub.matches(label, prop))
+                    targets.push_back(sub.callback);
+            }
+        }
+        for (auto &fn : targets) {
+            try {
+                fn(label, prop, value);
+            } catch (nb::python_error &e) {
+                e.discard_as_unraisable("pymmcore_nano property subscription");
+            }
+        }
+    }
+
+    std::atomic<MMEventCallback *> downstream_{nullptr};
+    std::mutex mutex_;
+    std::vector<Subscription> subscriptions_;
+    size_t lastId_ = 0;
+};
+
+///////////////// Per-core binding state ///////////////////
+
+/**
+ * @brief SLM patterns stored in device format, so that showing one again
+ * skips validation and conversion.
+ */
+class SLMPatternCache {
+  public:
+    struct Pattern {
+        std::string slmLabel;
+        std::vector<unsigned char> pixels;
+    };
+
+    size_t add(std::string slmLabel, std::vector<unsigned char> pixels) {
+        auto pattern =
+            std::make_shared<const Pattern>(Pattern{std::move(slmLabel), std::move(pixels)});
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t id = nextId_++;
+        patterns_.emplace(id, std::move(pattern));
+        return id;
+    }
+
+    // The returned pattern stays valid even if it is removed concurrently.
+    std::shared_ptr<const Pattern> get(size_t id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = patterns_.find(id);
+        if (it == patterns_.end())
+            throw std::invalid_argument("Unknown SLM pattern id " + std::to_string(id));
+        return it->second;
+    }
+
+    bool remove(size_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return patterns_.erase(id) > 0;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        patterns_.clear();
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::map<size_t, std::shared_ptr<const Pattern>> patterns_;
+    size_t nextId_ = 1;
+};
+
+/**
+ * @brief Frame settings (corrections, software ROIs) registered per camera
+ * label.
+ *
+ * Looked up on every frame retrieval with the GIL released, so access is
+ * guarded by its own mutex; `empty()` is a lock-free fast path.
+ */
+template <typename T> class CameraSettings {
+  public:
+    void set(const std::string &camera, std::shared_ptr<const T> setting) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        settings_[camera] = std::move(setting);
+        count_ = settings_.size();
+    }
+
+    // An empty label clears the settings of all cameras.
+    void clear(const std::string &camera) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (camera.empty())
+            settings_.clear();
+        else
+            settings_.erase(camera);
+        count_ = settings_.size();
+    }
+
+    std::shared_ptr<const T> get(const std::string &camera) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = settings_.find(camera);
+        return it == settings_.end() ? nullptr : it->second;
+    }
+
+    StrVec cameras() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        StrVec labels;
+        for (const auto &[camera, setting] : settings_)
+            labels.push_back(camera);
+        return labels;
+    }
+
+    bool empty() const { return count_.load(std::memory_order_relaxed) == 0; }
+
+  private:
+    mutable std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<const T>> settings_;
+    std::atomic<size_t> count_{0};
+};
+
+/**
+ * @brief State owned by the bindings (rather than by MMCore) for one CMMCore.
+ *
+ * CMMCore is bound directly, so this lives in a side table keyed by the core
+ * instance.  It is created on first use and destroyed by a weakref callback
+ * when the Python CMMCore object dies, which happens before the C++ CMMCore
+ * destructor runs.
+ */
+struct CoreExtensions {
+    explicit CoreExtensions(CMMCore &core) : core(core) { core.registerCallback(&router); }
+    ~CoreExtensions() { core.registerCallback(nullptr); }
+
+    CMMCore &core;
+    EventRouter router;
+    SLMPatternCache slmPatterns;
+    SerialReadBuffers serialBuffers;
+    LoggerLevels loggerLevels;
+    CameraSettings<FrameCorrection> frameCorrections;
+    CameraSettings<SoftwareROI> softwareROIs;
+    // Guards the logging state below.
+    std::mutex logMutex;
+    std::shared_ptr<LogSink> logSink;
+    std::map<int, bool> secondaryLogs; // handle -> enableDebug
+};
+
+static std::mutex g_extensions_mutex;
+static std::unordered_map<const CMMCore *, std::unique_ptr<CoreExtensions>> g_extensions;
+
+/** @brief Returns the binding state for `core`, creating it if needed.
+ *
+ * Must be called with the GIL held.  g_extensions_mutex is never held while
+ * creating Python objects: that can run the garbage collector, and the
+ * weakref callback of a collected core takes the same mutex.
+ */
+CoreExtensions &core_extensions(CMMCore &core) {
+    {
+        std::lock_guard<std::mutex> lock(g_extensions_mutex);
+        auto it = g_extensions.find(&core);
+        if (it != g_extensions.end())
+            return *it->second;
+    }
+
+    nb::object self = nb::find(core);
+    if (!self.is_valid())
+        throw std::runtime_error("CMMCore instance is not owned by Python");
+
+    const CMMCore *key = &core;
+    nb::object cleanup = nb::cpp_function([key](nb::handle weakref) {
+        std::unique_ptr<CoreExtensions> ext;
+        {
+            std::lock_guard<std::mutex> lock(g_extensions_mutex);
+            auto found = g_extensions.find(key);
+            if (found != g_extensions.end()) {
+                ext = std::move(found->second);
+                g_extensions.erase(found);
+            }
+        }
+        ext.reset();
+        weakref.dec_ref();
+    });
+    nb::weakref weak(self, cleanup);
+
+    std::lock_guard<std::mutex> lock(g_extensions_mutex);
+    auto it = g_extensions.find(key);
+    if (it != g_extensions.end())
+        return *it->second; // created by another thread meanwhile; `weak` is dropped
+    auto &ext = g_extensions[key];
+    ext = std::make_unique<CoreExtensions>(core);
+    // The weakref is intentionally leaked here and released by its own callback.
+    weak.release();
+    return *ext;
+}
+
+// Returns the binding state for `core` if it has any.  Unlike
+// core_extensions(), only looks up existing state and so needs no GIL.
+CoreExtensions *find_core_extensions(const CMMCore &core) {
+    std::lock_guard<std::mutex> lock(g_extensions_mutex);
+    auto it = g_extensions.find(&core);
+    return it == g_extensions.end() ? nullptr : it->second.get();
+}
+
+/*
+ * Property subscriptions hold Python callbacks in C++, where the garbage
+ * collector cannot see them.  These slots expose them, so that a core that is
+ * only referenced from its own callbacks (e.g. a bound method of an object
+ * holding the core) is collected.
+ */
+int cmmcore_tp_traverse(PyObject *self, visitproc visit, void *arg) {
+    Py_VISIT(Py_TYPE(self));
+    if (!nb::inst_ready(self))
+        return 0;
+    if (CoreExtensions *ext = find_core_extensions(*nb::inst_ptr<CMMCore>(self)))
+        return ext->router.traverse(visit, arg);
+    return 0;
+}
+
+int cmmcore_tp_clear(PyObject *self) {
+    if (!nb::inst_ready(self))
+        return 0;
+    if (CoreExtensions *ext = find_core_extensions(*nb::inst_ptr<CMMCore>(self)))
+        ext->router.clear();
+    return 0;
+}
+
+PyType_Slot cmmcore_slots[] = {{Py_tp_traverse, (void *)cmmcore_tp_traverse},
+                               {Py_tp_clear, (void *)cmmcore_tp_clear},
+                               {0, nullptr}};
+
+///////////////// Logging hook ///////////////////
+
+/**
+ * @brief Whether a message logged through the bindings should be formatted
+ * and passed on to MMCore.
+ *
+ * Decided from the level and logger name alone, so callers skip formatting
+ * the message when it is below the logger's threshold or none of MMCore's log
+ * outputs (including the in-memory sink's file) would record it.
+ */
+bool log_wanted(CMMCore &core, CoreExtensions &ext, mmcore::LogLevel level,
+                const std::string &logger) {
+    if (auto threshold = ext.loggerLevels.get(logger); threshold && level < *threshold)
+        return false;
+    bool secondary = false;
+    {
+        std::lock_guard<std::mutex> lock(ext.logMutex);
+        for (const auto &[handle, enableDebug] : ext.secondaryLogs)
+            secondary = secondary || enableDebug || level >= mmcore::LogLevelInfo;
+        if (ext.logSink)
+            secondary = secondary || ext.logSink->debug() || level >= mmcore::LogLevelInfo;
+    }
+    return secondary || level >= core.getPrimaryLogLevel() ||
+           (core.stderrLogEnabled() && level >= core.getStderrLogLevel());
+}
+
+// Passes a formatted message on to MMCore.  Called with the GIL held.
+void emit_log(CMMCore &core, mmcore::LogLevel level, const std::string &logger,
+              const std::string &text) {
+    nb::gil_scoped_release release;
+    core.log(text.c_str(), level, logger.c_str());
+}
+
+FrameSettings find_frame_settings(CMMCore &core, const Metadata *md) {
+    const CoreExtensions *ext = find_core_extensions(core);
+    if (!ext)
+        return {};
+    if (ext->frameCorrections.empty() && ext->softwareROIs.empty())
+        return {};
+    std::string camera;
+    if (md) {
+        try {
+            camera = md->GetSingleTag(MM::g_Keyword_Metadata_CameraLabel).GetValue();
+        } catch (...) {
+        }
+    }
+    if (camera.empty())
+        camera = core.getCameraDevice();
+    return {ext->frameCorrections.get(camera), ext->softwareROIs.get(camera)};
+}
+
 ////////////////////////////////////////////////////////////////////////////
 ///////////////// main _pymmcore_nano module definition  ///////////////////
 ////////////////////////////////////////////////////////////////////////////
@@ -312,6 +4080,71 @@ NB_MODULE(_pymmcore_nano, m) {
 #else
     m.attr("_MATCH_SWIG") = 0;
 #endif
+    m.attr("_HOLD_GIL") = GIL_HELD;
+
+    m.def(
+        "setGILPolicy",
+        [](const std::string &method, bool release) {
+            auto it = gil_policies().find(method);
+            if (it == gil_policies().end())
+                throw std::invalid_argument("No GIL policy for '" + method +
+                                            "'; see getGILPolicy() for the known methods");
+            it->second.release = release;
+        },
+        "method"_a, "release"_a,
+        R"doc(Sets whether calls to `method` release the GIL.
+
+
+`method` is a `CMMCore` method name, or `Class.method` for other classes, and
+applies to all overloads and all instances.  By default only getters of state
+cached by the core hold the GIL; releasing it costs more than those calls.
+Only hold it for calls that never wait on a device: a device thread calling
+back into Python while the caller waits for that device would deadlock.
+Has no methods to configure if built with `HOLD_GIL`.
+
+Methods that also work with Python objects (e.g. `tileScan`, `serialTransact`,
+`registerSLMPattern`) apply the policy around their device calls only.  Methods
+not listed by `getGILPolicy` always release the GIL while they wait: the log
+sink methods, and those of helper classes that wait on their own threads or
+only compute (`StageTelemetry.getSamples`, `SharedFrameReader.next`,
+`FrameCompressor.next`, `FrameCompressor.compress` and `decompress`).
+)doc");
+    m.def(
+        "getGILPolicy",
+        []() {
+            std::map<std::string, bool> policy;
+            for (const auto &[name, entry] : gil_policies())
+                policy.emplace(name, entry.release.load());
+            return policy;
+        },
+        "Returns `{method: releasesGIL}` for all methods with a configurable GIL policy.");
+    m.def(
+        "resetGILPolicy",
+        []() {
+            for (auto &[name, entry] : gil_policies())
+                entry.release = entry.releaseByDefault;
+        },
+        "Restores the default GIL policy of all methods.");
+    m.def(
+        "focusScore",
+        [](const nb::ndarray<nb::ro, nb::ndim<2>, nb::c_contig, nb::device::cpu> &image,
+           const std::string &metric) {
+            nb::dlpack::dtype dt = image.dtype();
+            if (dt.code != static_cast<uint8_t>(nb::dlpack::dtype_code::UInt) ||
+                (dt.bits != 8 && dt.bits != 16 && dt.bits != 32) || dt.lanes != 1)
+                throw std::invalid_argument("image must be a uint8, uint16 or uint32 array");
+            ImageGeometry g{static_cast<unsigned>(image.shape(1)),
+                            static_cast<unsigned>(image.shape(0)), dt.bits / 8u, 1};
+            return focus_score(image.data(), g, parse_focus_metric(metric));
+        },
+        "image"_a, "metric"_a = "brenner",
+        R"doc(Returns the focus score of a 2D grayscale image; higher is sharper.
+
+
+"brenner" is the mean squared difference of pixels two columns apart,
+"laplacian" the mean squared 4-neighbour Laplacian and "variance" the
+intensity variance divided by the mean.
+)doc" RGIL("focusScore"));
     m.attr("MM_CODE_OK") = MM_CODE_OK;
     m.attr("MM_CODE_ERR") = MM_CODE_ERR;
     m.attr("DEVICE_OK") = DEVICE_OK;
@@ -596,7 +4429,13 @@ A configuration is a collection of device property settings.
              nb::overload_cast<const char *, const char *>(&Configuration::getSetting),
              "device"_a, "property"_a)
         .def("size", &Configuration::size)
-        .def("getVerbose", &Configuration::getVerbose);
+        .def("getVerbose", &Configuration::getVerbose)
+        .def("to_arrays", &config_to_columns,
+             "Returns all settings as `(devices, properties, values)` lists in a single call.")
+        .def_static("from_arrays", &config_from_columns, "devices"_a, "properties"_a,
+                    "values"_a,
+                    "Builds a Configuration from parallel lists of devices, properties and "
+                    "values.");
 
     nb::class_<PropertySetting>(m, "PropertySetting")
         .def(nb::init<const char *, const char *, const char *, bool>(), "deviceLabel"_a,
@@ -615,49 +4454,57 @@ A configuration is a collection of device property settings.
         .def_static("generateKey", &PropertySetting::generateKey, "device"_a, "prop"_a,
                     "Generates a unique key based on device and property");
 
+    // Metadata objects may be shared between threads (e.g. filled by an
+    // acquisition thread, read by a UI thread).  nb::lock_self() serializes
+    // calls on one object in free-threaded builds and is a no-op otherwise.
     nb::class_<Metadata>(m, "Metadata")
         .def(nb::init<>(), "Empty constructor")
         .def(nb::init<const Metadata &>(), "Copy constructor")
         // Member functions
-        .def("Clear", &Metadata::Clear, "Clears all tags")
-        .def("GetKeys", &Metadata::GetKeys, "Returns all tag keys")
-        .def("HasTag", &Metadata::HasTag, "key"_a, "Checks if a tag exists for the given key")
-        .def("GetSingleTag", &Metadata::GetSingleTag, "key"_a, "Gets a single tag by key")
-        .def("GetArrayTag", &Metadata::GetArrayTag, "key"_a, "Gets an array tag by key")
-        .def("SetTag", &Metadata::SetTag, "tag"_a, "Sets a tag")
-        .def("RemoveTag", &Metadata::RemoveTag, "key"_a, "Removes a tag by key")
-        .def("Merge", &Metadata::Merge, "newTags"_a, "Merges new tags into the metadata")
-        .def("Serialize", &Metadata::Serialize, "Serializes the metadata")
-        .def("Restore", &Metadata::Restore, "stream"_a,
+        .def("Clear", &Metadata::Clear, nb::lock_self(), "Clears all tags")
+        .def("GetKeys", &Metadata::GetKeys, nb::lock_self(), "Returns all tag keys")
+        .def("HasTag", &Metadata::HasTag, "key"_a, nb::lock_self(),
+             "Checks if a tag exists for the given key")
+        .def("GetSingleTag", &Metadata::GetSingleTag, "key"_a, nb::lock_self(),
+             "Gets a single tag by key")
+        .def("GetArrayTag", &Metadata::GetArrayTag, "key"_a, nb::lock_self(),
+             "Gets an array tag by key")
+        .def("SetTag", &Metadata::SetTag, "tag"_a, nb::lock_self(), "Sets a tag")
+        .def("RemoveTag", &Metadata::RemoveTag, "key"_a, nb::lock_self(), "Removes a tag by key")
+        .def("Merge", &Metadata::Merge, "newTags"_a, nb::lock_self(),
+             "Merges new tags into the metadata")
+        .def("Serialize", &Metadata::Serialize, nb::lock_self(), "Serializes the metadata")
+        .def("Restore", &Metadata::Restore, "stream"_a, nb::lock_self(),
              "Restores metadata from a serialized string")
-        .def("Dump", &Metadata::Dump, "Dumps metadata in human-readable format")
+        .def("Dump", &Metadata::Dump, nb::lock_self(),
+             "Dumps metadata in human-readable format")
         // Template methods (bound using lambdas due to C++ template limitations
         // in bindings)
         .def(
             "PutTag",
             [](Metadata &self, const std::string &key, const std::string &deviceLabel,
                const std::string &value) { self.PutTag(key, deviceLabel, value); },
-            "key"_a, "deviceLabel"_a, "value"_a, "Adds a MetadataSingleTag")
+            "key"_a, "deviceLabel"_a, "value"_a, nb::lock_self(), "Adds a MetadataSingleTag")
 
         .def(
             "PutImageTag",
             [](Metadata &self, const std::string &key, const std::string &value) {
                 self.PutImageTag(key, value);
             },
-            "key"_a, "value"_a, "Adds an image tag")
+            "key"_a, "value"_a, nb::lock_self(), "Adds an image tag")
         // MutableMapping Methods:
         .def("__getitem__",
              [](Metadata &self, const std::string &key) {
                  MetadataSingleTag tag = self.GetSingleTag(key.c_str());
                  return tag.GetValue();
-             })
+             }, nb::lock_self())
         .def("__setitem__",
              [](Metadata &self, const std::string &key, const std::string &value) {
                  MetadataSingleTag tag(key.c_str(), "__", false);
                  tag.SetValue(value.c_str());
                  self.SetTag(tag);
-             })
-        .def("__delitem__", &Metadata::RemoveTag);
+             }, nb::lock_self())
+        .def("__delitem__", &Metadata::RemoveTag, nb::lock_self());
     //  .def("__iter__",
     //       [m](Metadata &self) {
     //         StrVec keys = self.GetKeys();
@@ -792,7 +4639,8 @@ Use by passing an instance to [`CMMCore.registerCallback`][pymmcore_nano.CMMCore
 
     //////////////////// MMCore ////////////////////
 
-    nb::class_<CMMCore>(m, "CMMCore", R"doc(
+    nb::class_<CMMCore>(m, "CMMCore", nb::is_weak_referenceable(), nb::type_slots(cmmcore_slots),
+                        R"doc(
 The main MMCore object.
 
 
@@ -804,205 +4652,531 @@ programming.
         .def(
             "loadSystemConfiguration",
             // accept any object that can be cast to a string (e.g. Path)
-            [](CMMCore &self, nb::object fileName) {
-                self.loadSystemConfiguration(nb::str(fileName).c_str());
+            [gil = gil_policy_flag("loadSystemConfiguration")](CMMCore &self, nb::object fileName) {
+                std::string path = nb::str(fileName).c_str();
+                gil_policy_scope release(gil);
+                self.loadSystemConfiguration(path.c_str());
             },
             "fileName"_a,
             nb::sig("def loadSystemConfiguration(self, fileName: str | os.PathLike) -> None"),
-            "Loads a system configuration from a file.")
-        .def("saveSystemConfiguration", &CMMCore::saveSystemConfiguration, "fileName"_a RGIL)
-        .def_static("enableFeature", &CMMCore::enableFeature, "name"_a, "enable"_a RGIL)
-        .def_static("isFeatureEnabled", &CMMCore::isFeatureEnabled, "name"_a RGIL)
-        .def_static("getMMCoreVersionMajor", &CMMCore::getMMCoreVersionMajor RGIL)
-        .def_static("getMMCoreVersionMinor", &CMMCore::getMMCoreVersionMinor RGIL)
-        .def_static("getMMCoreVersionPatch", &CMMCore::getMMCoreVersionPatch RGIL)
-        .def_static("getMMDeviceModuleInterfaceVersion", &CMMCore::getMMDeviceModuleInterfaceVersion RGIL)
-        .def_static("getMMDeviceDeviceInterfaceVersion", &CMMCore::getMMDeviceDeviceInterfaceVersion RGIL)
-        .def("loadDevice", &CMMCore::loadDevice, "label"_a, "moduleName"_a, "deviceName"_a RGIL)
-        .def("unloadDevice", &CMMCore::unloadDevice, "label"_a RGIL)
+            R"doc(Loads a system configuration from a file.
+
+
+To time the initialization of each device, load a configuration without the
+"Property,Core,Initialize,1" line and then call `initializeAllDevicesTimed`.
+)doc")
+        .def(
+            "validateSystemConfiguration",
+            [gil = gil_policy_flag("validateSystemConfiguration")](CMMCore &self,
+                                                                   nb::object fileName) {
+                std::string path = nb::str(fileName).c_str();
+                gil_policy_scope release(gil);
+                return validate_system_configuration(self, path);
+            },
+            "fileName"_a,
+            nb::sig("def validateSystemConfiguration(self, fileName: str | os.PathLike) -> "
+                    "list[str]"),
+            R"doc(Checks a system configuration file without loading any device.
+
+
+Returns a list of problems (empty if none were found), each prefixed with the
+offending line number.
+)doc")
+        .def("saveSystemConfiguration", &CMMCore::saveSystemConfiguration, "fileName"_a RGIL("saveSystemConfiguration"))
+        .def_static("enableFeature", &CMMCore::enableFeature, "name"_a, "enable"_a RGIL("enableFeature"))
+        .def_static("isFeatureEnabled", &CMMCore::isFeatureEnabled, "name"_a RGIL("isFeatureEnabled"))
+        .def_static("getMMCoreVersionMajor", &CMMCore::getMMCoreVersionMajor RGIL("getMMCoreVersionMajor"))
+        .def_static("getMMCoreVersionMinor", &CMMCore::getMMCoreVersionMinor RGIL("getMMCoreVersionMinor"))
+        .def_static("getMMCoreVersionPatch", &CMMCore::getMMCoreVersionPatch RGIL("getMMCoreVersionPatch"))
+        .def_static("getMMDeviceModuleInterfaceVersion", &CMMCore::getMMDeviceModuleInterfaceVersion RGIL("getMMDeviceModuleInterfaceVersion"))
+        .def_static("getMMDeviceDeviceInterfaceVersion", &CMMCore::getMMDeviceDeviceInterfaceVersion RGIL("getMMDeviceDeviceInterfaceVersion"))
+        .def("loadDevice", &CMMCore::loadDevice, "label"_a, "moduleName"_a, "deviceName"_a RGIL("loadDevice"))
+        .def("unloadDevice", &CMMCore::unloadDevice, "label"_a RGIL("unloadDevice"))
         .def("unloadAllDevices", &CMMCore::unloadAllDevices)
-        .def("initializeAllDevices", &CMMCore::initializeAllDevices RGIL)
-        .def("initializeDevice", &CMMCore::initializeDevice, "label"_a RGIL)
-        .def("getDeviceInitializationState", &CMMCore::getDeviceInitializationState, "label"_a RGIL)
-        .def("reset", &CMMCore::reset RGIL)
-        .def("unloadLibrary", &CMMCore::unloadLibrary, "moduleName"_a RGIL)
-        .def("updateCoreProperties", &CMMCore::updateCoreProperties RGIL)
-        .def("getCoreErrorText", &CMMCore::getCoreErrorText, "code"_a RGIL)
-        .def("getVersionInfo", &CMMCore::getVersionInfo RGIL)
-        .def("getAPIVersionInfo", &CMMCore::getAPIVersionInfo RGIL)
-        .def("getSystemState", &CMMCore::getSystemState RGIL)
-        .def("setSystemState", &CMMCore::setSystemState, "conf"_a RGIL)
-        .def("getConfigState", &CMMCore::getConfigState, "group"_a, "config"_a RGIL)
+        .def("initializeAllDevices", &CMMCore::initializeAllDevices RGIL("initializeAllDevices"))
+        .def(
+            "getDeviceInitializationOrder",
+            [](CMMCore &self) { return device_init_levels(self); },
+            R"doc(Returns the loaded devices grouped into dependency levels.
+
+
+Devices depend on their parent hub and on the serial port named by their "Port"
+property.  Devices in one level only depend on devices in earlier levels, and
+are therefore independent of each other.
+)doc" RGIL("getDeviceInitializationOrder"))
+        .def(
+            "getDeviceConcurrencyGroups",
+            [](CMMCore &self) {
+                // MMCore serializes all calls into one device adapter module, so
+                // devices are independent exactly when their libraries differ.
+                std::vector<StrVec> groups;
+                std::map<std::string, size_t> index;
+                for (const auto &label : self.getLoadedDevices()) {
+                    if (label == MM::g_Keyword_CoreDevice)
+                        continue;
+                    std::string library = self.getDeviceLibrary(label.c_str());
+                    auto [it, inserted] = index.emplace(library, groups.size());
+                    if (inserted)
+                        groups.emplace_back();
+                    groups[it->second].push_back(label);
+                }
+                return groups;
+            },
+            R"doc(Returns the loaded devices grouped by the lock that serializes them.
+
+
+Unless the module was built with `HOLD_GIL`, device calls release the GIL, so
+they may be made from several Python threads at once.  MMCore guards each
+device adapter module with its own lock: calls on devices in different groups
+run in parallel, while calls on devices within one group are serialized.
+)doc" RGIL("getDeviceConcurrencyGroups"))
+        .def(
+            "initializeAllDevicesTimed",
+            [](CMMCore &self) { return initialize_devices(self); },
+            R"doc(Initializes all uninitialized devices in dependency order and assigns the default roles.
+
+
+Returns a list of `(label, seconds)` tuples giving the time spent initializing
+each device, to help identify slow device adapters.  Devices are initialized
+one at a time, as MMCore's core-wide bookkeeping is not thread-safe; for
+concurrent initialization, enable MMCore's process-wide
+"ParallelDeviceInitialization" feature and call `initializeAllDevices()`.
+)doc" RGIL("initializeAllDevicesTimed"))
+        .def("initializeDevice", &CMMCore::initializeDevice, "label"_a RGIL("initializeDevice"))
+        .def("getDeviceInitializationState", &CMMCore::getDeviceInitializationState, "label"_a RGIL("getDeviceInitializationState"))
+        .def("reset", &CMMCore::reset RGIL("reset"))
+        .def("unloadLibrary", &CMMCore::unloadLibrary, "moduleName"_a RGIL("unloadLibrary"))
+        .def("updateCoreProperties", &CMMCore::updateCoreProperties RGIL("updateCoreProperties"))
+        .def("getCoreErrorText", &CMMCore::getCoreErrorText, "code"_a RGIL("getCoreErrorText"))
+        .def("getVersionInfo", &CMMCore::getVersionInfo RGIL("getVersionInfo"))
+        .def("getAPIVersionInfo", &CMMCore::getAPIVersionInfo RGIL("getAPIVersionInfo"))
+        .def("getSystemState", &CMMCore::getSystemState RGIL("getSystemState"))
+        .def("setSystemState", &CMMCore::setSystemState, "conf"_a RGIL("setSystemState"))
+        .def("getConfigState", &CMMCore::getConfigState, "group"_a, "config"_a RGIL("getConfigState"))
         .def("getConfigGroupState",
              nb::overload_cast<const char *>(&CMMCore::getConfigGroupState),
-             "group"_a RGIL)
-        .def("saveSystemState", &CMMCore::saveSystemState, "fileName"_a RGIL)
-        .def("loadSystemState", &CMMCore::loadSystemState, "fileName"_a RGIL)
-        .def("registerCallback", &CMMCore::registerCallback, R"doc(Register a callback (listener class).
+             "group"_a RGIL("getConfigGroupState"))
+        .def("saveSystemState", &CMMCore::saveSystemState, "fileName"_a RGIL("saveSystemState"))
+        .def("loadSystemState", &CMMCore::loadSystemState, "fileName"_a RGIL("loadSystemState"))
+        .def(
+            "getSystemSnapshot",
+            [gil = gil_policy_flag("getSystemSnapshot")](CMMCore &self) {
+                std::string data;
+                {
+                    gil_policy_scope release(gil);
+                    data = pack_snapshot(capture_snapshot(self));
+                }
+                return nb::bytes(data.data(), data.size());
+            },
+            R"doc(Returns a compact binary (msgpack) snapshot of the system state.
+
+
+The snapshot holds the property cache, config groups, pixel size configs and the
+current camera's ROI and exposure.  Restore it with `setSystemSnapshot`.
+)doc")
+        .def(
+            "setSystemSnapshot",
+            [gil = gil_policy_flag("setSystemSnapshot")](CMMCore &self, nb::bytes snapshot) {
+                std::string data(snapshot.c_str(), snapshot.size());
+                gil_policy_scope release(gil);
+                return apply_snapshot(self, unpack_snapshot(data.data(), data.size()));
+            },
+            "snapshot"_a,
+            R"doc(Restores a snapshot made by `getSystemSnapshot`, applying only differences.
+
+
+Properties are compared against the system state cache, and only config groups
+and pixel size configs that differ are redefined.  Properties of devices that
+are not loaded are skipped.  Returns the number of changes applied.
+)doc")
+        .def(
+            "saveSystemSnapshot",
+            [gil = gil_policy_flag("saveSystemSnapshot")](CMMCore &self, nb::object fileName) {
+                std::string path = nb::str(fileName).c_str();
+                gil_policy_scope release(gil);
+                std::string data = pack_snapshot(capture_snapshot(self));
+                std::ofstream file(path, std::ios::binary);
+                if (!file.write(data.data(), data.size()))
+                    throw std::runtime_error("Cannot write system snapshot file: " + path);
+            },
+            "fileName"_a,
+            nb::sig("def saveSystemSnapshot(self, fileName: str | os.PathLike) -> None"),
+            "Saves a binary system snapshot (see `getSystemSnapshot`) to a file.")
+        .def(
+            "loadSystemSnapshot",
+            [gil = gil_policy_flag("loadSystemSnapshot")](CMMCore &self, nb::object fileName) {
+                std::string path = nb::str(fileName).c_str();
+                gil_policy_scope release(gil);
+                std::ifstream file(path, std::ios::binary);
+                if (!file)
+                    throw std::invalid_argument("Cannot open system snapshot file: " + path);
+                std::string data((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+                return apply_snapshot(self, unpack_snapshot(data.data(), data.size()));
+            },
+            "fileName"_a,
+            nb::sig("def loadSystemSnapshot(self, fileName: str | os.PathLike) -> int"),
+            "Restores a binary system snapshot file, applying only differences. Returns the "
+            "number of changes applied.")
+        .def(
+            "registerCallback",
+            [](CMMCore &self, MMEventCallback *cb) {
+                core_extensions(self).router.setDownstream(cb);
+            },
+            R"doc(Register a callback (listener class).
+
+
+MMCore will send notifications on internal events using this interface
+          )doc", nb::arg("cb").none(), nb::keep_alive<1, 2>())
+        .def(
+            "subscribeProperty",
+            [](CMMCore &self, std::string label, std::string propName, nb::callable callback) {
+                return core_extensions(self).router.subscribe(std::move(label),
+                                                              std::move(propName), callback);
+            },
+            "label"_a, "propName"_a, "callback"_a,
+            R"doc(Call `callback(label, propName, value)` when a matching property changes.
+
+
+Either `label` or `propName` may be `"*"` to match any device or any property.
+Events are filtered in C++, so property changes without a matching subscription
+never acquire the GIL.  Returns an id for use with `unsubscribeProperty`.
+)doc")
+        .def(
+            "unsubscribeProperty",
+            [](CMMCore &self, size_t subscriptionId) {
+                return core_extensions(self).router.unsubscribe(subscriptionId);
+            },
+            "subscriptionId"_a,
+            "Remove a subscription made with `subscribeProperty`. Returns False if the id is "
+            "unknown.")
+        .def(
+            "setPrimaryLogFile",
+            // accept any object that can be cast to a string (e.g. Path)
+            [](CMMCore &self, nb::object filename, bool truncate) {
+                // convert to string
+                self.setPrimaryLogFile(nb::str(filename).c_str(), truncate);
+            },
+            "filename"_a,
+            "truncate"_a = false )
+
+        .def("getPrimaryLogFile", &CMMCore::getPrimaryLogFile RGIL("getPrimaryLogFile"))
+        .def(
+            "logMessage",
+            [](CMMCore &self, const std::string &msg, bool debugOnly) {
+                auto level = debugOnly ? mmcore::LogLevelDebug : mmcore::LogLevelInfo;
+                if (log_wanted(self, core_extensions(self), level, "App")) {
+                    nb::gil_scoped_release release;
+                    self.logMessage(msg.c_str(), debugOnly);
+                }
+            },
+            "msg"_a, "debugOnly"_a = false)
+
+        .def("enableDebugLog", &CMMCore::enableDebugLog, "enable"_a RGIL("enableDebugLog"))
+        .def("debugLogEnabled", &CMMCore::debugLogEnabled RGIL("debugLogEnabled"))
+        .def("enableStderrLog", &CMMCore::enableStderrLog, "enable"_a RGIL("enableStderrLog"))
+        .def("stderrLogEnabled", &CMMCore::stderrLogEnabled RGIL("stderrLogEnabled"))
+        .def("setStderrLogLevel", &CMMCore::setStderrLogLevel, "level"_a RGIL("setStderrLogLevel"))
+        .def("getStderrLogLevel", &CMMCore::getStderrLogLevel RGIL("getStderrLogLevel"))
+        .def(
+            "startSecondaryLogFile",
+            // accept any object that can be cast to a string (e.g. Path)
+            [](CMMCore &self,
+               nb::object filename,
+               bool enableDebug,
+               bool truncate,
+               bool synchronous) {
+                CoreExtensions &ext = core_extensions(self);
+                int handle = self.startSecondaryLogFile(nb::str(filename).c_str(), enableDebug,
+                                                        truncate, synchronous);
+                std::lock_guard<std::mutex> lock(ext.logMutex);
+                ext.secondaryLogs[handle] = enableDebug;
+                return handle;
+            },
+            "filename"_a,
+            "enableDebug"_a,
+            "truncate"_a = true,
+            "synchronous"_a = false )
+        .def(
+            "stopSecondaryLogFile",
+            [](CMMCore &self, int handle) {
+                CoreExtensions &ext = core_extensions(self);
+                self.stopSecondaryLogFile(handle);
+                std::lock_guard<std::mutex> lock(ext.logMutex);
+                ext.secondaryLogs.erase(handle);
+            },
+            "handle"_a)
+        .def(
+            "startLogSink",
+            [](CMMCore &self, size_t capacity, bool enableDebug) {
+                CoreExtensions &ext = core_extensions(self);
+                std::shared_ptr<LogSink> old;
+                {
+                    nb::gil_scoped_release release;
+                    auto sink = std::make_shared<LogSink>(self, capacity, enableDebug);
+                    std::lock_guard<std::mutex> lock(ext.logMutex);
+                    old = std::exchange(ext.logSink, std::move(sink));
+                }
+                nb::gil_scoped_release release;
+                old.reset(); // joins its reader thread
+            },
+            "capacity"_a = 100000, "enableDebug"_a = false,
+            R"doc(Starts collecting MMCore's log output into a bounded in-memory buffer.
+
+
+Everything MMCore logs, including messages from device adapters and from
+`log`/`logMessage`, is captured as structured records retrieved with
+`drainLogRecords`; debug messages only if `enableDebug` is set.  The sink is a
+secondary log file in the temporary directory that is parsed incrementally in
+the background, so records appear shortly after MMCore writes them; a
+multi-line message becomes a single record.  Once
+`capacity` records are buffered, the oldest are dropped.  Restarting the sink
+discards buffered records.
+)doc")
+        .def(
+            "stopLogSink",
+            [](CMMCore &self) {
+                CoreExtensions &ext = core_extensions(self);
+                std::shared_ptr<LogSink> sink;
+                {
+                    std::lock_guard<std::mutex> lock(ext.logMutex);
+                    sink = std::move(ext.logSink);
+                }
+                nb::gil_scoped_release release;
+                sink.reset();
+            },
+            "Stops the in-memory log sink and discards its buffered records.")
+        .def(
+            "drainLogRecords",
+            [](CMMCore &self, size_t maxRecords) {
+                CoreExtensions &ext = core_extensions(self);
+                std::shared_ptr<LogSink> sink;
+                {
+                    std::lock_guard<std::mutex> lock(ext.logMutex);
+                    sink = ext.logSink;
+                }
+                if (!sink)
+                    throw std::runtime_error("The log sink is not running; call startLogSink()");
+                size_t dropped = 0;
+                std::vector<LogRecord> records;
+                {
+                    nb::gil_scoped_release release;
+                    records = sink->drain(maxRecords, dropped);
+                }
+
+                std::vector<double> time;
+                std::vector<int32_t> level;
+                std::vector<uint64_t> thread;
+                nb::list logger, message;
+                time.reserve(records.size());
+                level.reserve(records.size());
+                thread.reserve(records.size());
+                for (const auto &r : records) {
+                    time.push_back(r.time);
+                    level.push_back(r.level);
+                    thread.push_back(r.thread);
+                    logger.append(nb::str(r.logger.data(), r.logger.size()));
+                    message.append(nb::str(r.message.data(), r.message.size()));
+                }
+                nb::dict result;
+                result["time"] = owned_array(std::move(time));
+                result["level"] = owned_array(std::move(level));
+                result["thread"] = owned_array(std::move(thread));
+                result["logger"] = logger;
+                result["message"] = message;
+                result["dropped"] = dropped;
+                return result;
+            },
+            "maxRecords"_a = 0,
+            nb::sig("def drainLogRecords(self, maxRecords: int = 0) -> dict[str, typing.Any]"),
+            R"doc(Removes and returns the oldest buffered log records (all if `maxRecords` is 0).
+
+
+Returns a dict of columns: `time` (float64 seconds since the epoch), `level`
+(int32 `LogLevel` values) and `thread` (uint64) arrays, `logger` and `message`
+lists of str, plus `dropped`, the number of records lost to overflow since the
+previous drain.
+)doc")
+        .def("setPrimaryLogFileRotation", &CMMCore::setPrimaryLogFileRotation,
+             "maxFileSize"_a, "maxBackupCount"_a RGIL("setPrimaryLogFileRotation"))
+        .def(
+            "log",
+            [](CMMCore &self, const std::string &msg, mmcore::LogLevel level,
+               const std::string &loggerName) {
+                if (log_wanted(self, core_extensions(self), level, loggerName))
+                    emit_log(self, level, loggerName, msg);
+            },
+            "msg"_a, "level"_a, "loggerName"_a = "App")
+        .def(
+            "log",
+            [](CMMCore &self, nb::callable msg, mmcore::LogLevel level,
+               const std::string &loggerName) {
+                if (!log_wanted(self, core_extensions(self), level, loggerName))
+                    return;
+                std::string text = nb::cast<std::string>(nb::str(msg()));
+                emit_log(self, level, loggerName, text);
+            },
+            "msg"_a, "level"_a, "loggerName"_a = "App",
+            nb::sig("def log(self, msg: typing.Callable[[], object], level: LogLevel, "
+                    "loggerName: str = 'App') -> None"),
+            R"doc(Logs a lazily formatted message.
 
 
-MMCore will send notifications on internal events using this interface
-          )doc", nb::arg("cb").none(), nb::keep_alive<1, 2>() RGIL)
+`msg()` is only called if the message passes `loggerName`'s threshold (see
+`setLoggerLevel`), if it has one, and the level of the primary log, the stderr
+log, a secondary log file or the in-memory log sink.
+)doc")
+        .def("setPrimaryLogLevel", &CMMCore::setPrimaryLogLevel, "level"_a RGIL("setPrimaryLogLevel"))
+        .def("getPrimaryLogLevel", &CMMCore::getPrimaryLogLevel RGIL("getPrimaryLogLevel"))
         .def(
-            "setPrimaryLogFile",
-            // accept any object that can be cast to a string (e.g. Path)
-            [](CMMCore &self, nb::object filename, bool truncate) {
-                // convert to string
-                self.setPrimaryLogFile(nb::str(filename).c_str(), truncate);
+            "setLoggerLevel",
+            [](CMMCore &self, const std::string &loggerName, mmcore::LogLevel level) {
+                core_extensions(self).loggerLevels.set(loggerName, level);
             },
-            "filename"_a,
-            "truncate"_a = false )
+            "loggerName"_a, "level"_a,
+            R"doc(Sets the minimum level for one logger (a `log` logger name, or "App").
+
 
-        .def("getPrimaryLogFile", &CMMCore::getPrimaryLogFile RGIL)
-        .def("logMessage", nb::overload_cast<const char *>(&CMMCore::logMessage), "msg"_a RGIL)
-        .def("logMessage",
-             nb::overload_cast<const char *, bool>(&CMMCore::logMessage),
-             "msg"_a,
-             "debugOnly"_a RGIL)
+Messages logged through `log` and `logMessage` below the threshold are dropped
+before they are formatted.  Messages at or above it are passed on to MMCore,
+whose log outputs still filter them at their own levels; a threshold never
+changes the primary log level.
 
-        .def("enableDebugLog", &CMMCore::enableDebugLog, "enable"_a RGIL)
-        .def("debugLogEnabled", &CMMCore::debugLogEnabled RGIL)
-        .def("enableStderrLog", &CMMCore::enableStderrLog, "enable"_a RGIL)
-        .def("stderrLogEnabled", &CMMCore::stderrLogEnabled RGIL)
-        .def("setStderrLogLevel", &CMMCore::setStderrLogLevel, "level"_a RGIL)
-        .def("getStderrLogLevel", &CMMCore::getStderrLogLevel RGIL)
+Only messages logged through these bindings are covered.  Messages that MMCore
+and device adapters log internally go straight to MMCore's log outputs and are
+not affected by any threshold.
+)doc")
         .def(
-            "startSecondaryLogFile",
-            // accept any object that can be cast to a string (e.g. Path)
-            [](CMMCore &self,
-               nb::object filename,
-               bool enableDebug,
-               bool truncate,
-               bool synchronous) {
-                return self.startSecondaryLogFile(nb::str(filename).c_str(), enableDebug,
-                                                  truncate, synchronous);
+            "getLoggerLevel",
+            [](CMMCore &self, const std::string &loggerName) {
+                return core_extensions(self).loggerLevels.get(loggerName);
             },
-            "filename"_a,
-            "enableDebug"_a,
-            "truncate"_a = true,
-            "synchronous"_a = false )
-        .def("stopSecondaryLogFile", &CMMCore::stopSecondaryLogFile, "handle"_a RGIL)
-        .def("setPrimaryLogFileRotation", &CMMCore::setPrimaryLogFileRotation,
-             "maxFileSize"_a, "maxBackupCount"_a RGIL)
-        .def("log",
-             nb::overload_cast<const char *, mmcore::LogLevel>(&CMMCore::log),
-             "msg"_a, "level"_a RGIL)
-        .def("log",
-             nb::overload_cast<const char *, mmcore::LogLevel, const char *>(&CMMCore::log),
-             "msg"_a, "level"_a, "loggerName"_a RGIL)
-        .def("setPrimaryLogLevel", &CMMCore::setPrimaryLogLevel, "level"_a RGIL)
-        .def("getPrimaryLogLevel", &CMMCore::getPrimaryLogLevel RGIL)
-
-        .def("getDeviceAdapterSearchPaths", &CMMCore::getDeviceAdapterSearchPaths RGIL)
-        .def("setDeviceAdapterSearchPaths", &CMMCore::setDeviceAdapterSearchPaths, "paths"_a RGIL)
-        .def("getDeviceAdapterNames", &CMMCore::getDeviceAdapterNames RGIL)
-        .def("getAvailableDevices", &CMMCore::getAvailableDevices, "library"_a RGIL)
+            "loggerName"_a, "Returns the logger's threshold, or None if it has none.")
+        .def(
+            "resetLoggerLevel",
+            [](CMMCore &self, const std::string &loggerName) {
+                core_extensions(self).loggerLevels.reset(loggerName);
+            },
+            "loggerName"_a, "Removes the logger's threshold.")
+        .def(
+            "getLoggerLevels",
+            [](CMMCore &self) { return core_extensions(self).loggerLevels.all(); },
+            "Returns all per-logger thresholds as a dict.")
+        .def(
+            "clearLoggerLevels",
+            [](CMMCore &self) { core_extensions(self).loggerLevels.clear(); },
+            "Removes all per-logger thresholds.")
+
+        .def("getDeviceAdapterSearchPaths", &CMMCore::getDeviceAdapterSearchPaths RGIL("getDeviceAdapterSearchPaths"))
+        .def("setDeviceAdapterSearchPaths", &CMMCore::setDeviceAdapterSearchPaths, "paths"_a RGIL("setDeviceAdapterSearchPaths"))
+        .def("getDeviceAdapterNames", &CMMCore::getDeviceAdapterNames RGIL("getDeviceAdapterNames"))
+        .def("getAvailableDevices", &CMMCore::getAvailableDevices, "library"_a RGIL("getAvailableDevices"))
         .def("getAvailableDeviceDescriptions",
              &CMMCore::getAvailableDeviceDescriptions,
-             "library"_a RGIL)
-        .def("getAvailableDeviceTypes", &CMMCore::getAvailableDeviceTypes, "library"_a RGIL)
-        .def("getLoadedDevices", &CMMCore::getLoadedDevices RGIL)
-        .def("getLoadedDevicesOfType", &CMMCore::getLoadedDevicesOfType, "devType"_a RGIL)
-        .def("getDeviceType", &CMMCore::getDeviceType, "label"_a RGIL)
-        .def("getDeviceLibrary", &CMMCore::getDeviceLibrary, "label"_a RGIL)
+             "library"_a RGIL("getAvailableDeviceDescriptions"))
+        .def("getAvailableDeviceTypes", &CMMCore::getAvailableDeviceTypes, "library"_a RGIL("getAvailableDeviceTypes"))
+        .def("getLoadedDevices", &CMMCore::getLoadedDevices RGIL("getLoadedDevices"))
+        .def("getLoadedDevicesOfType", &CMMCore::getLoadedDevicesOfType, "devType"_a RGIL("getLoadedDevicesOfType"))
+        .def("getDeviceType", &CMMCore::getDeviceType, "label"_a RGIL("getDeviceType"))
+        .def("getDeviceLibrary", &CMMCore::getDeviceLibrary, "label"_a RGIL("getDeviceLibrary"))
         .def("getDeviceName",
              nb::overload_cast<const char *>(&CMMCore::getDeviceName),
-             "label"_a RGIL)
-        .def("getDeviceDescription", &CMMCore::getDeviceDescription, "label"_a RGIL)
-        .def("getDevicePropertyNames", &CMMCore::getDevicePropertyNames, "label"_a RGIL)
-        .def("hasProperty", &CMMCore::hasProperty, "label"_a, "propName"_a RGIL)
-        .def("getProperty", &CMMCore::getProperty, "label"_a, "propName"_a RGIL)
+             "label"_a RGIL("getDeviceName"))
+        .def("getDeviceDescription", &CMMCore::getDeviceDescription, "label"_a RGIL("getDeviceDescription"))
+        .def("getDevicePropertyNames", &CMMCore::getDevicePropertyNames, "label"_a RGIL("getDevicePropertyNames"))
+        .def("hasProperty", &CMMCore::hasProperty, "label"_a, "propName"_a RGIL("hasProperty"))
+        .def("getProperty", &CMMCore::getProperty, "label"_a, "propName"_a RGIL("getProperty"))
         .def("setProperty",
              nb::overload_cast<const char *, const char *, const char *>(&CMMCore::setProperty),
              "label"_a,
              "propName"_a,
-             "propValue"_a RGIL)
+             "propValue"_a RGIL("setProperty"))
         .def("setProperty",
              nb::overload_cast<const char *, const char *, bool>(&CMMCore::setProperty),
              "label"_a,
              "propName"_a,
-             "propValue"_a RGIL)
+             "propValue"_a RGIL("setProperty"))
         .def("setProperty",
              nb::overload_cast<const char *, const char *, long>(&CMMCore::setProperty),
              "label"_a,
              "propName"_a,
-             "propValue"_a RGIL)
+             "propValue"_a RGIL("setProperty"))
         .def("setProperty",
              nb::overload_cast<const char *, const char *, float>(&CMMCore::setProperty),
              "label"_a,
              "propName"_a,
-             "propValue"_a RGIL)
+             "propValue"_a RGIL("setProperty"))
         .def("getAllowedPropertyValues",
              &CMMCore::getAllowedPropertyValues,
              "label"_a,
-             "propName"_a RGIL)
-        .def("isPropertyReadOnly", &CMMCore::isPropertyReadOnly, "label"_a, "propName"_a RGIL)
-        .def("isPropertyPreInit", &CMMCore::isPropertyPreInit, "label"_a, "propName"_a RGIL)
-        .def(
-            "isPropertySequenceable", &CMMCore::isPropertySequenceable, "label"_a, "propName"_a RGIL)
-        .def("hasPropertyLimits", &CMMCore::hasPropertyLimits, "label"_a, "propName"_a RGIL)
-        .def("getPropertyLowerLimit", &CMMCore::getPropertyLowerLimit, "label"_a, "propName"_a RGIL)
-        .def("getPropertyUpperLimit", &CMMCore::getPropertyUpperLimit, "label"_a, "propName"_a RGIL)
-        .def("getPropertyType", &CMMCore::getPropertyType, "label"_a, "propName"_a RGIL)
-        .def("startPropertySequence", &CMMCore::startPropertySequence, "label"_a, "propName"_a RGIL)
-        .def("stopPropertySequence", &CMMCore::stopPropertySequence, "label"_a, "propName"_a RGIL)
+             "propName"_a RGIL("getAllowedPropertyValues"))
+        .def("isPropertyReadOnly", &CMMCore::isPropertyReadOnly, "label"_a, "propName"_a RGIL("isPropertyReadOnly"))
+        .def("isPropertyPreInit", &CMMCore::isPropertyPreInit, "label"_a, "propName"_a RGIL("isPropertyPreInit"))
+        .def(
+            "isPropertySequenceable", &CMMCore::isPropertySequenceable, "label"_a, "propName"_a RGIL("isPropertySequenceable"))
+        .def("hasPropertyLimits", &CMMCore::hasPropertyLimits, "label"_a, "propName"_a RGIL("hasPropertyLimits"))
+        .def("getPropertyLowerLimit", &CMMCore::getPropertyLowerLimit, "label"_a, "propName"_a RGIL("getPropertyLowerLimit"))
+        .def("getPropertyUpperLimit", &CMMCore::getPropertyUpperLimit, "label"_a, "propName"_a RGIL("getPropertyUpperLimit"))
+        .def("getPropertyType", &CMMCore::getPropertyType, "label"_a, "propName"_a RGIL("getPropertyType"))
+        .def("startPropertySequence", &CMMCore::startPropertySequence, "label"_a, "propName"_a RGIL("startPropertySequence"))
+        .def("stopPropertySequence", &CMMCore::stopPropertySequence, "label"_a, "propName"_a RGIL("stopPropertySequence"))
         .def("getPropertySequenceMaxLength",
              &CMMCore::getPropertySequenceMaxLength,
              "label"_a,
-             "propName"_a RGIL)
+             "propName"_a RGIL("getPropertySequenceMaxLength"))
         .def("loadPropertySequence",
              &CMMCore::loadPropertySequence,
              "label"_a,
              "propName"_a,
-             "eventSequence"_a RGIL)
-        .def("deviceBusy", &CMMCore::deviceBusy, "label"_a RGIL)
+             "eventSequence"_a RGIL("loadPropertySequence"))
+        .def("deviceBusy", &CMMCore::deviceBusy, "label"_a RGIL("deviceBusy"))
         .def("waitForDevice",
              nb::overload_cast<const char *>(&CMMCore::waitForDevice),
-             "label"_a RGIL)
-        .def("waitForConfig", &CMMCore::waitForConfig, "group"_a, "configName"_a RGIL)
-        .def("systemBusy", &CMMCore::systemBusy RGIL)
-        .def("waitForSystem", &CMMCore::waitForSystem RGIL)
-        .def("deviceTypeBusy", &CMMCore::deviceTypeBusy, "devType"_a RGIL)
-        .def("waitForDeviceType", &CMMCore::waitForDeviceType, "devType"_a RGIL)
-        .def("getDeviceDelayMs", &CMMCore::getDeviceDelayMs, "label"_a RGIL)
-        .def("setDeviceDelayMs", &CMMCore::setDeviceDelayMs, "label"_a, "delayMs"_a RGIL)
-        .def("usesDeviceDelay", &CMMCore::usesDeviceDelay, "label"_a RGIL)
-        .def("setTimeoutMs", &CMMCore::setTimeoutMs, "timeoutMs"_a RGIL)
-        .def("getTimeoutMs", &CMMCore::getTimeoutMs RGIL)
-        .def("sleep", &CMMCore::sleep, "intervalMs"_a RGIL)
-
-        .def("getCameraDevice", &CMMCore::getCameraDevice RGIL)
-        .def("getShutterDevice", &CMMCore::getShutterDevice RGIL)
-        .def("getFocusDevice", &CMMCore::getFocusDevice RGIL)
-        .def("getXYStageDevice", &CMMCore::getXYStageDevice RGIL)
-        .def("getAutoFocusDevice", &CMMCore::getAutoFocusDevice RGIL)
-        .def("getImageProcessorDevice", &CMMCore::getImageProcessorDevice RGIL)
-        .def("getSLMDevice", &CMMCore::getSLMDevice RGIL)
-        .def("getGalvoDevice", &CMMCore::getGalvoDevice RGIL)
-        .def("getChannelGroup", &CMMCore::getChannelGroup RGIL)
-        .def("setCameraDevice", &CMMCore::setCameraDevice, "cameraLabel"_a RGIL)
-        .def("setShutterDevice", &CMMCore::setShutterDevice, "shutterLabel"_a RGIL)
-        .def("setFocusDevice", &CMMCore::setFocusDevice, "focusLabel"_a RGIL)
-        .def("setXYStageDevice", &CMMCore::setXYStageDevice, "xyStageLabel"_a RGIL)
-        .def("setAutoFocusDevice", &CMMCore::setAutoFocusDevice, "focusLabel"_a RGIL)
-        .def("setImageProcessorDevice", &CMMCore::setImageProcessorDevice, "procLabel"_a RGIL)
-        .def("setSLMDevice", &CMMCore::setSLMDevice, "slmLabel"_a RGIL)
-        .def("setGalvoDevice", &CMMCore::setGalvoDevice, "galvoLabel"_a RGIL)
-        .def("setChannelGroup", &CMMCore::setChannelGroup, "channelGroup"_a RGIL)
-
-        .def("getSystemStateCache", &CMMCore::getSystemStateCache RGIL)
-        .def("updateSystemStateCache", &CMMCore::updateSystemStateCache RGIL)
+             "label"_a RGIL("waitForDevice"))
+        .def("waitForConfig", &CMMCore::waitForConfig, "group"_a, "configName"_a RGIL("waitForConfig"))
+        .def("systemBusy", &CMMCore::systemBusy RGIL("systemBusy"))
+        .def("waitForSystem", &CMMCore::waitForSystem RGIL("waitForSystem"))
+        .def("deviceTypeBusy", &CMMCore::deviceTypeBusy, "devType"_a RGIL("deviceTypeBusy"))
+        .def("waitForDeviceType", &CMMCore::waitForDeviceType, "devType"_a RGIL("waitForDeviceType"))
+        .def("getDeviceDelayMs", &CMMCore::getDeviceDelayMs, "label"_a RGIL("getDeviceDelayMs"))
+        .def("setDeviceDelayMs", &CMMCore::setDeviceDelayMs, "label"_a, "delayMs"_a RGIL("setDeviceDelayMs"))
+        .def("usesDeviceDelay", &CMMCore::usesDeviceDelay, "label"_a RGIL("usesDeviceDelay"))
+        .def("setTimeoutMs", &CMMCore::setTimeoutMs, "timeoutMs"_a RGIL("setTimeoutMs"))
+        .def("getTimeoutMs", &CMMCore::getTimeoutMs RGIL("getTimeoutMs"))
+        .def("sleep", &CMMCore::sleep, "intervalMs"_a RGIL("sleep"))
+
+        .def("getCameraDevice", &CMMCore::getCameraDevice RGIL("getCameraDevice"))
+        .def("getShutterDevice", &CMMCore::getShutterDevice RGIL("getShutterDevice"))
+        .def("getFocusDevice", &CMMCore::getFocusDevice RGIL("getFocusDevice"))
+        .def("getXYStageDevice", &CMMCore::getXYStageDevice RGIL("getXYStageDevice"))
+        .def("getAutoFocusDevice", &CMMCore::getAutoFocusDevice RGIL("getAutoFocusDevice"))
+        .def("getImageProcessorDevice", &CMMCore::getImageProcessorDevice RGIL("getImageProcessorDevice"))
+        .def("getSLMDevice", &CMMCore::getSLMDevice RGIL("getSLMDevice"))
+        .def("getGalvoDevice", &CMMCore::getGalvoDevice RGIL("getGalvoDevice"))
+        .def("getChannelGroup", &CMMCore::getChannelGroup RGIL("getChannelGroup"))
+        .def("setCameraDevice", &CMMCore::setCameraDevice, "cameraLabel"_a RGIL("setCameraDevice"))
+        .def("setShutterDevice", &CMMCore::setShutterDevice, "shutterLabel"_a RGIL("setShutterDevice"))
+        .def("setFocusDevice", &CMMCore::setFocusDevice, "focusLabel"_a RGIL("setFocusDevice"))
+        .def("setXYStageDevice", &CMMCore::setXYStageDevice, "xyStageLabel"_a RGIL("setXYStageDevice"))
+        .def("setAutoFocusDevice", &CMMCore::setAutoFocusDevice, "focusLabel"_a RGIL("setAutoFocusDevice"))
+        .def("setImageProcessorDevice", &CMMCore::setImageProcessorDevice, "procLabel"_a RGIL("setImageProcessorDevice"))
+        .def("setSLMDevice", &CMMCore::setSLMDevice, "slmLabel"_a RGIL("setSLMDevice"))
+        .def("setGalvoDevice", &CMMCore::setGalvoDevice, "galvoLabel"_a RGIL("setGalvoDevice"))
+        .def("setChannelGroup", &CMMCore::setChannelGroup, "channelGroup"_a RGIL("setChannelGroup"))
+
+        .def("getSystemStateCache", &CMMCore::getSystemStateCache RGIL("getSystemStateCache"))
+        .def("updateSystemStateCache", &CMMCore::updateSystemStateCache RGIL("updateSystemStateCache"))
         .def("getPropertyFromCache",
              &CMMCore::getPropertyFromCache,
              "deviceLabel"_a,
-             "propName"_a RGIL)
-        .def("getCurrentConfigFromCache", &CMMCore::getCurrentConfigFromCache, "groupName"_a RGIL)
-        .def("getConfigGroupStateFromCache", &CMMCore::getConfigGroupStateFromCache, "group"_a RGIL)
+             "propName"_a RGIL("getPropertyFromCache"))
+        .def("getCurrentConfigFromCache", &CMMCore::getCurrentConfigFromCache, "groupName"_a RGIL("getCurrentConfigFromCache"))
+        .def("getConfigGroupStateFromCache", &CMMCore::getConfigGroupStateFromCache, "group"_a RGIL("getConfigGroupStateFromCache"))
 
         .def("defineConfig",
              nb::overload_cast<const char *, const char *>(&CMMCore::defineConfig ),
              "groupName"_a,
-             "configName"_a RGIL)
+             "configName"_a RGIL("defineConfig"))
         .def("defineConfig",
              nb::overload_cast<const char *,
                                const char *,
@@ -1013,47 +5187,55 @@ MMCore will send notifications on internal events using this interface
              "configName"_a,
              "deviceLabel"_a,
              "propName"_a,
-             "value"_a RGIL)
-        .def("defineConfigGroup", &CMMCore::defineConfigGroup, "groupName"_a RGIL)
-        .def("deleteConfigGroup", &CMMCore::deleteConfigGroup, "groupName"_a RGIL)
+             "value"_a RGIL("defineConfig"))
+        .def("defineConfigGroup", &CMMCore::defineConfigGroup, "groupName"_a RGIL("defineConfigGroup"))
+        .def("deleteConfigGroup", &CMMCore::deleteConfigGroup, "groupName"_a RGIL("deleteConfigGroup"))
         .def("renameConfigGroup",
              &CMMCore::renameConfigGroup,
              "oldGroupName"_a,
-             "newGroupName"_a RGIL)
-        .def("isGroupDefined", &CMMCore::isGroupDefined, "groupName"_a RGIL)
-        .def("isConfigDefined", &CMMCore::isConfigDefined, "groupName"_a, "configName"_a RGIL)
-        .def("setConfig", &CMMCore::setConfig, "groupName"_a, "configName"_a RGIL)
+             "newGroupName"_a RGIL("renameConfigGroup"))
+        .def("isGroupDefined", &CMMCore::isGroupDefined, "groupName"_a RGIL("isGroupDefined"))
+        .def("isConfigDefined", &CMMCore::isConfigDefined, "groupName"_a, "configName"_a RGIL("isConfigDefined"))
+        .def("setConfig", &CMMCore::setConfig, "groupName"_a, "configName"_a RGIL("setConfig"))
 
         .def("deleteConfig",
              nb::overload_cast<const char *, const char *>(&CMMCore::deleteConfig),
              "groupName"_a,
-             "configName"_a RGIL)
+             "configName"_a RGIL("deleteConfig"))
         .def("deleteConfig",
              nb::overload_cast<const char *, const char *, const char *, const char *>(
                  &CMMCore::deleteConfig),
              "groupName"_a,
              "configName"_a,
              "deviceLabel"_a,
-             "propName"_a RGIL)
+             "propName"_a RGIL("deleteConfig"))
 
         .def("renameConfig",
              &CMMCore::renameConfig,
              "groupName"_a,
              "oldConfigName"_a,
-             "newConfigName"_a RGIL)
-        .def("getAvailableConfigGroups", &CMMCore::getAvailableConfigGroups RGIL)
-        .def("getAvailableConfigs", &CMMCore::getAvailableConfigs, "configGroup"_a RGIL)
-        .def("getCurrentConfig", &CMMCore::getCurrentConfig, "groupName"_a RGIL)
-        .def("getConfigData", &CMMCore::getConfigData, "configGroup"_a, "configName"_a RGIL)
+             "newConfigName"_a RGIL("renameConfig"))
+        .def("getAvailableConfigGroups", &CMMCore::getAvailableConfigGroups RGIL("getAvailableConfigGroups"))
+        .def("getAvailableConfigs", &CMMCore::getAvailableConfigs, "configGroup"_a RGIL("getAvailableConfigs"))
+        .def("getCurrentConfig", &CMMCore::getCurrentConfig, "groupName"_a RGIL("getCurrentConfig"))
+        .def("getConfigData", &CMMCore::getConfigData, "configGroup"_a, "configName"_a RGIL("getConfigData"))
+        .def(
+            "getConfigDataArrays",
+            [](CMMCore &self, const char *configGroup, const char *configName) {
+                return config_to_columns(self.getConfigData(configGroup, configName));
+            },
+            "configGroup"_a, "configName"_a,
+            "Returns the settings of a preset as `(devices, properties, values)` lists, like "
+            "`getConfigData(...).to_arrays()`." RGIL("getConfigDataArrays"))
 
         .def("getCurrentPixelSizeConfig",
-             nb::overload_cast<>(&CMMCore::getCurrentPixelSizeConfig) RGIL)
+             nb::overload_cast<>(&CMMCore::getCurrentPixelSizeConfig) RGIL("getCurrentPixelSizeConfig"))
         .def("getCurrentPixelSizeConfig",
              nb::overload_cast<bool>(&CMMCore::getCurrentPixelSizeConfig),
-             "cached"_a RGIL)
-        .def("getPixelSizeUm", nb::overload_cast<>(&CMMCore::getPixelSizeUm) RGIL)
-        .def("getPixelSizeUm", nb::overload_cast<bool>(&CMMCore::getPixelSizeUm), "cached"_a RGIL)
-        .def("getPixelSizeUmByID", &CMMCore::getPixelSizeUmByID, "resolutionID"_a RGIL)
+             "cached"_a RGIL("getCurrentPixelSizeConfig"))
+        .def("getPixelSizeUm", nb::overload_cast<>(&CMMCore::getPixelSizeUm) RGIL("getPixelSizeUm"))
+        .def("getPixelSizeUm", nb::overload_cast<bool>(&CMMCore::getPixelSizeUm), "cached"_a RGIL("getPixelSizeUm"))
+        .def("getPixelSizeUmByID", &CMMCore::getPixelSizeUmByID, "resolutionID"_a RGIL("getPixelSizeUmByID"))
         .def("getPixelSizeAffine",
              [](CMMCore &self) {
                 std::vector<double> v;
@@ -1076,22 +5258,22 @@ MMCore will send notifications on internal events using this interface
              }, "resolutionID"_a,
              nb::sig("def getPixelSizeAffineByID(self, resolutionID: str) -> tuple[float, float, float, float, float, float]"))
 
-        .def("getPixelSizedxdz", nb::overload_cast<>(&CMMCore::getPixelSizedxdz) RGIL)
-        .def("getPixelSizedxdz", nb::overload_cast<bool>(&CMMCore::getPixelSizedxdz), "cached"_a RGIL)
-        .def("getPixelSizedxdz", nb::overload_cast<const char*>(&CMMCore::getPixelSizedxdz), "resolutionID"_a RGIL)
-        .def("getPixelSizedydz", nb::overload_cast<>(&CMMCore::getPixelSizedydz) RGIL)
-        .def("getPixelSizedydz", nb::overload_cast<bool>(&CMMCore::getPixelSizedydz), "cached"_a RGIL)
-        .def("getPixelSizedydz", nb::overload_cast<const char*>(&CMMCore::getPixelSizedydz), "resolutionID"_a RGIL)
-        .def("getPixelSizeOptimalZUm", nb::overload_cast<>(&CMMCore::getPixelSizeOptimalZUm) RGIL)
-        .def("getPixelSizeOptimalZUm", nb::overload_cast<bool>(&CMMCore::getPixelSizeOptimalZUm), "cached"_a RGIL)
-        .def("getPixelSizeOptimalZUm", nb::overload_cast<const char*>(&CMMCore::getPixelSizeOptimalZUm), "resolutionID"_a RGIL)
-        .def("setPixelSizedxdz", &CMMCore::setPixelSizedxdz, "resolutionID"_a, "dXdZ"_a RGIL)
-        .def("setPixelSizedydz", &CMMCore::setPixelSizedydz, "resolutionID"_a, "dYdZ"_a RGIL)
-        .def("setPixelSizeOptimalZUm", &CMMCore::setPixelSizeOptimalZUm, "resolutionID"_a, "optimalZ"_a RGIL)
-
-        .def("getMagnificationFactor", &CMMCore::getMagnificationFactor RGIL)
-        .def("setPixelSizeUm", &CMMCore::setPixelSizeUm, "resolutionID"_a, "pixSize"_a RGIL)
-        .def("setPixelSizeAffine", &CMMCore::setPixelSizeAffine, "resolutionID"_a, "affine"_a RGIL)
+        .def("getPixelSizedxdz", nb::overload_cast<>(&CMMCore::getPixelSizedxdz) RGIL("getPixelSizedxdz"))
+        .def("getPixelSizedxdz", nb::overload_cast<bool>(&CMMCore::getPixelSizedxdz), "cached"_a RGIL("getPixelSizedxdz"))
+        .def("getPixelSizedxdz", nb::overload_cast<const char*>(&CMMCore::getPixelSizedxdz), "resolutionID"_a RGIL("getPixelSizedxdz"))
+        .def("getPixelSizedydz", nb::overload_cast<>(&CMMCore::getPixelSizedydz) RGIL("getPixelSizedydz"))
+        .def("getPixelSizedydz", nb::overload_cast<bool>(&CMMCore::getPixelSizedydz), "cached"_a RGIL("getPixelSizedydz"))
+        .def("getPixelSizedydz", nb::overload_cast<const char*>(&CMMCore::getPixelSizedydz), "resolutionID"_a RGIL("getPixelSizedydz"))
+        .def("getPixelSizeOptimalZUm", nb::overload_cast<>(&CMMCore::getPixelSizeOptimalZUm) RGIL("getPixelSizeOptimalZUm"))
+        .def("getPixelSizeOptimalZUm", nb::overload_cast<bool>(&CMMCore::getPixelSizeOptimalZUm), "cached"_a RGIL("getPixelSizeOptimalZUm"))
+        .def("getPixelSizeOptimalZUm", nb::overload_cast<const char*>(&CMMCore::getPixelSizeOptimalZUm), "resolutionID"_a RGIL("getPixelSizeOptimalZUm"))
+        .def("setPixelSizedxdz", &CMMCore::setPixelSizedxdz, "resolutionID"_a, "dXdZ"_a RGIL("setPixelSizedxdz"))
+        .def("setPixelSizedydz", &CMMCore::setPixelSizedydz, "resolutionID"_a, "dYdZ"_a RGIL("setPixelSizedydz"))
+        .def("setPixelSizeOptimalZUm", &CMMCore::setPixelSizeOptimalZUm, "resolutionID"_a, "optimalZ"_a RGIL("setPixelSizeOptimalZUm"))
+
+        .def("getMagnificationFactor", &CMMCore::getMagnificationFactor RGIL("getMagnificationFactor"))
+        .def("setPixelSizeUm", &CMMCore::setPixelSizeUm, "resolutionID"_a, "pixSize"_a RGIL("setPixelSizeUm"))
+        .def("setPixelSizeAffine", &CMMCore::setPixelSizeAffine, "resolutionID"_a, "affine"_a RGIL("setPixelSizeAffine"))
 
         .def("definePixelSizeConfig",
              nb::overload_cast<const char *, const char *, const char *, const char *>(
@@ -1099,19 +5281,27 @@ MMCore will send notifications on internal events using this interface
              "resolutionID"_a,
              "deviceLabel"_a,
              "propName"_a,
-             "value"_a RGIL)
+             "value"_a RGIL("definePixelSizeConfig"))
         .def("definePixelSizeConfig",
              nb::overload_cast<const char *>(&CMMCore::definePixelSizeConfig),
-             "resolutionID"_a RGIL)
-        .def("getAvailablePixelSizeConfigs", &CMMCore::getAvailablePixelSizeConfigs RGIL)
-        .def("isPixelSizeConfigDefined", &CMMCore::isPixelSizeConfigDefined, "resolutionID"_a RGIL)
-        .def("setPixelSizeConfig", &CMMCore::setPixelSizeConfig, "resolutionID"_a RGIL)
+             "resolutionID"_a RGIL("definePixelSizeConfig"))
+        .def("getAvailablePixelSizeConfigs", &CMMCore::getAvailablePixelSizeConfigs RGIL("getAvailablePixelSizeConfigs"))
+        .def("isPixelSizeConfigDefined", &CMMCore::isPixelSizeConfigDefined, "resolutionID"_a RGIL("isPixelSizeConfigDefined"))
+        .def("setPixelSizeConfig", &CMMCore::setPixelSizeConfig, "resolutionID"_a RGIL("setPixelSizeConfig"))
         .def("renamePixelSizeConfig",
              &CMMCore::renamePixelSizeConfig,
              "oldConfigName"_a,
-             "newConfigName"_a RGIL)
-        .def("deletePixelSizeConfig", &CMMCore::deletePixelSizeConfig, "configName"_a RGIL)
-        .def("getPixelSizeConfigData", &CMMCore::getPixelSizeConfigData, "configName"_a RGIL)
+             "newConfigName"_a RGIL("renamePixelSizeConfig"))
+        .def("deletePixelSizeConfig", &CMMCore::deletePixelSizeConfig, "configName"_a RGIL("deletePixelSizeConfig"))
+        .def("getPixelSizeConfigData", &CMMCore::getPixelSizeConfigData, "configName"_a RGIL("getPixelSizeConfigData"))
+        .def(
+            "getPixelSizeConfigDataArrays",
+            [](CMMCore &self, const char *configName) {
+                return config_to_columns(self.getPixelSizeConfigData(configName));
+            },
+            "configName"_a,
+            "Returns the settings of a pixel size preset as `(devices, properties, values)` "
+            "lists, like `getPixelSizeConfigData(...).to_arrays()`." RGIL("getPixelSizeConfigDataArrays"))
 
         // Image Acquisition Methods
         .def("setROI",
@@ -1119,20 +5309,20 @@ MMCore will send notifications on internal events using this interface
              "x"_a,
              "y"_a,
              "xSize"_a,
-             "ySize"_a RGIL)
+             "ySize"_a RGIL("setROI"))
         .def("setROI",
              nb::overload_cast<const char *, int, int, int, int>(&CMMCore::setROI),
              "label"_a,
              "x"_a,
              "y"_a,
              "xSize"_a,
-             "ySize"_a RGIL)
+             "ySize"_a RGIL("setROI"))
         .def("getROI",
              [](CMMCore &self) {
                 int x, y, xSize, ySize;
                 self.getROI(x, y, xSize, ySize);            // Call C++ method
                 return std::make_tuple(x, y, xSize, ySize); // Return a tuple
-             } RGIL)
+             } RGIL("getROI"))
         .def(
             "getROI",
             [](CMMCore &self, const char *label) {
@@ -1140,11 +5330,11 @@ MMCore will send notifications on internal events using this interface
                 self.getROI(label, x, y, xSize, ySize);     // Call the C++ method
                 return std::make_tuple(x, y, xSize, ySize); // Return as Python tuple
             },
-            "label"_a RGIL)
-        .def("clearROI", &CMMCore::clearROI RGIL)
-        .def("isMultiROISupported", &CMMCore::isMultiROISupported RGIL)
-        .def("isMultiROIEnabled", &CMMCore::isMultiROIEnabled RGIL)
-        .def("setMultiROI", &CMMCore::setMultiROI, "xs"_a, "ys"_a, "widths"_a, "heights"_a RGIL)
+            "label"_a RGIL("getROI"))
+        .def("clearROI", &CMMCore::clearROI RGIL("clearROI"))
+        .def("isMultiROISupported", &CMMCore::isMultiROISupported RGIL("isMultiROISupported"))
+        .def("isMultiROIEnabled", &CMMCore::isMultiROIEnabled RGIL("isMultiROIEnabled"))
+        .def("setMultiROI", &CMMCore::setMultiROI, "xs"_a, "ys"_a, "widths"_a, "heights"_a RGIL("setMultiROI"))
         .def("getMultiROI",
              [](CMMCore &self) -> std::tuple<std::vector<unsigned>,
                                              std::vector<unsigned>,
@@ -1153,89 +5343,328 @@ MMCore will send notifications on internal events using this interface
                 std::vector<unsigned> xs, ys, widths, heights;
                 self.getMultiROI(xs, ys, widths, heights);
                 return {xs, ys, widths, heights};
-             } RGIL)
+             } RGIL("getMultiROI"))
 
-        .def("setExposure", nb::overload_cast<double>(&CMMCore::setExposure), "exp"_a RGIL)
+        .def("setExposure", nb::overload_cast<double>(&CMMCore::setExposure), "exp"_a RGIL("setExposure"))
         .def("setExposure",
              nb::overload_cast<const char *, double>(&CMMCore::setExposure),
              "cameraLabel"_a,
-             "dExp"_a RGIL)
-        .def("getExposure", nb::overload_cast<>(&CMMCore::getExposure) RGIL)
-        .def("getExposure", nb::overload_cast<const char *>(&CMMCore::getExposure), "label"_a RGIL)
+             "dExp"_a RGIL("setExposure"))
+        .def("getExposure", nb::overload_cast<>(&CMMCore::getExposure) RGIL("getExposure"))
+        .def("getExposure", nb::overload_cast<const char *>(&CMMCore::getExposure), "label"_a RGIL("getExposure"))
 
-        .def("getBinning", nb::overload_cast<>(&CMMCore::getBinning) RGIL)
-        .def("getBinning", nb::overload_cast<const char *>(&CMMCore::getBinning), "label"_a RGIL)
-        .def("getAllowedBinningValues", nb::overload_cast<>(&CMMCore::getAllowedBinningValues) RGIL)
+        .def("getBinning", nb::overload_cast<>(&CMMCore::getBinning) RGIL("getBinning"))
+        .def("getBinning", nb::overload_cast<const char *>(&CMMCore::getBinning), "label"_a RGIL("getBinning"))
+        .def("getAllowedBinningValues", nb::overload_cast<>(&CMMCore::getAllowedBinningValues) RGIL("getAllowedBinningValues"))
         .def("getAllowedBinningValues",
              nb::overload_cast<const char *>(&CMMCore::getAllowedBinningValues),
-             "label"_a RGIL)
-        .def("setBinning", nb::overload_cast<long>(&CMMCore::setBinning), "binning"_a RGIL)
+             "label"_a RGIL("getAllowedBinningValues"))
+        .def("setBinning", nb::overload_cast<long>(&CMMCore::setBinning), "binning"_a RGIL("setBinning"))
         .def("setBinning",
              nb::overload_cast<const char *, long>(&CMMCore::setBinning),
              "label"_a,
-             "binning"_a RGIL)
+             "binning"_a RGIL("setBinning"))
+
+        .def("snapImage", &CMMCore::snapImage RGIL("snapImage"))
+        .def(
+            "tileScan",
+            [gil = gil_policy_flag("tileScan")](CMMCore &self, tile_positions positions,
+                                                nb::callable frameCallback) {
+                gil_policy_scope release(gil);
+                run_tile_scan(self, positions, frameCallback);
+            },
+            "positions"_a, "frameCallback"_a,
+            R"doc(Snaps one image at each row of an (N, 2) or (N, 3) array of x, y[, z] positions.
+
 
-        .def("snapImage", &CMMCore::snapImage RGIL)
+Uses the current XY stage and, for three columns, the current focus device.  The
+move to the next position starts as soon as the exposure ends, overlapping with
+camera readout and with `frameCallback(index, image, position)`, which is
+called for every frame with the commanded position tuple.
+)doc")
         .def(
             "getImage",
             [](CMMCore &self) -> np_array {
-                return create_image_array(self, self.getImage()); } RGIL)
+                return create_image_array(self, self.getImage()); } RGIL("getImage"))
         .def("getImage",
              [](CMMCore &self, unsigned channel) -> np_array {
                 return create_image_array(self, self.getImage(channel));
-             }, "numChannel"_a RGIL)
-        .def("getImageWidth", &CMMCore::getImageWidth RGIL)
-        .def("getImageHeight", &CMMCore::getImageHeight RGIL)
-        .def("getBytesPerPixel", &CMMCore::getBytesPerPixel RGIL)
-        .def("getImageBitDepth", &CMMCore::getImageBitDepth RGIL)
-        .def("getNumberOfComponents", &CMMCore::getNumberOfComponents RGIL)
-        .def("getNumberOfCameraChannels", &CMMCore::getNumberOfCameraChannels RGIL)
-        .def("getCameraChannelName", &CMMCore::getCameraChannelName, "channelNr"_a RGIL)
-        .def("getImageBufferSize", &CMMCore::getImageBufferSize RGIL)
-        .def("setAutoShutter", &CMMCore::setAutoShutter, "state"_a RGIL)
-        .def("getAutoShutter", &CMMCore::getAutoShutter RGIL)
-        .def("setShutterOpen", nb::overload_cast<bool>(&CMMCore::setShutterOpen), "state"_a RGIL)
-        .def("getShutterOpen", nb::overload_cast<>(&CMMCore::getShutterOpen) RGIL)
+             }, "numChannel"_a RGIL("getImage"))
+        .def(
+            "getImage",
+            [](CMMCore &self, const std::string &framework) {
+                return framework_image(framework,
+                                       [&] { return create_image_array(self, self.getImage()); });
+            },
+            nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_DOC)
+        .def(
+            "getImage",
+            [](CMMCore &self, unsigned channel, const std::string &framework) {
+                return framework_image(
+                    framework, [&] { return create_image_array(self, self.getImage(channel)); });
+            },
+            "numChannel"_a, nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_DOC)
+        .def("getImageWidth", &CMMCore::getImageWidth RGIL("getImageWidth"))
+        .def("getImageHeight", &CMMCore::getImageHeight RGIL("getImageHeight"))
+        .def("getBytesPerPixel", &CMMCore::getBytesPerPixel RGIL("getBytesPerPixel"))
+        .def("getImageBitDepth", &CMMCore::getImageBitDepth RGIL("getImageBitDepth"))
+        .def("getNumberOfComponents", &CMMCore::getNumberOfComponents RGIL("getNumberOfComponents"))
+        .def("getNumberOfCameraChannels", &CMMCore::getNumberOfCameraChannels RGIL("getNumberOfCameraChannels"))
+        .def("getCameraChannelName", &CMMCore::getCameraChannelName, "channelNr"_a RGIL("getCameraChannelName"))
+        .def("getImageBufferSize", &CMMCore::getImageBufferSize RGIL("getImageBufferSize"))
+        .def("setAutoShutter", &CMMCore::setAutoShutter, "state"_a RGIL("setAutoShutter"))
+        .def("getAutoShutter", &CMMCore::getAutoShutter RGIL("getAutoShutter"))
+        .def("setShutterOpen", nb::overload_cast<bool>(&CMMCore::setShutterOpen), "state"_a RGIL("setShutterOpen"))
+        .def("getShutterOpen", nb::overload_cast<>(&CMMCore::getShutterOpen) RGIL("getShutterOpen"))
         .def("setShutterOpen",
              nb::overload_cast<const char *, bool>(&CMMCore::setShutterOpen),
              "shutterLabel"_a,
-             "state"_a RGIL)
+             "state"_a RGIL("setShutterOpen"))
         .def("getShutterOpen",
              nb::overload_cast<const char *>(&CMMCore::getShutterOpen),
-             "shutterLabel"_a RGIL)
+             "shutterLabel"_a RGIL("getShutterOpen"))
         .def("startSequenceAcquisition",
              nb::overload_cast<long, double, bool>(&CMMCore::startSequenceAcquisition),
              "numImages"_a,
              "intervalMs"_a,
-             "stopOnOverflow"_a RGIL)
+             "stopOnOverflow"_a RGIL("startSequenceAcquisition"))
         .def("startSequenceAcquisition",
              nb::overload_cast<const char *, long, double, bool>(
                  &CMMCore::startSequenceAcquisition),
              "cameraLabel"_a,
              "numImages"_a,
              "intervalMs"_a,
-             "stopOnOverflow"_a RGIL)
+             "stopOnOverflow"_a RGIL("startSequenceAcquisition"))
         .def(
-            "prepareSequenceAcquisition", &CMMCore::prepareSequenceAcquisition, "cameraLabel"_a RGIL)
+            "prepareSequenceAcquisition", &CMMCore::prepareSequenceAcquisition, "cameraLabel"_a RGIL("prepareSequenceAcquisition"))
         .def("startContinuousSequenceAcquisition",
              &CMMCore::startContinuousSequenceAcquisition,
-             "intervalMs"_a RGIL)
-        .def("stopSequenceAcquisition", nb::overload_cast<>(&CMMCore::stopSequenceAcquisition) RGIL)
+             "intervalMs"_a RGIL("startContinuousSequenceAcquisition"))
+        .def("stopSequenceAcquisition", nb::overload_cast<>(&CMMCore::stopSequenceAcquisition) RGIL("stopSequenceAcquisition"))
         .def("stopSequenceAcquisition",
              nb::overload_cast<const char *>(&CMMCore::stopSequenceAcquisition),
-             "cameraLabel"_a RGIL)
-        .def("isSequenceRunning", nb::overload_cast<>(&CMMCore::isSequenceRunning) RGIL)
+             "cameraLabel"_a RGIL("stopSequenceAcquisition"))
+        .def("isSequenceRunning", nb::overload_cast<>(&CMMCore::isSequenceRunning) RGIL("isSequenceRunning"))
         .def("isSequenceRunning",
              nb::overload_cast<const char *>(&CMMCore::isSequenceRunning),
-             "cameraLabel"_a RGIL)
+             "cameraLabel"_a RGIL("isSequenceRunning"))
         .def("getLastImage",
              [](CMMCore &self) -> np_array {
                 return create_image_array(self, self.getLastImage());
-             } RGIL)
+             } RGIL("getLastImage"))
         .def("popNextImage",
              [](CMMCore &self) -> np_array {
                 return create_image_array(self, self.popNextImage());
-             } RGIL)
+             } RGIL("popNextImage"))
+        .def(
+            "getLastImage",
+            [](CMMCore &self, const std::string &framework) {
+                return framework_image(
+                    framework, [&] { return create_image_array(self, self.getLastImage()); });
+            },
+            nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_DOC)
+        .def(
+            "popNextImage",
+            [](CMMCore &self, const std::string &framework) {
+                return framework_image(
+                    framework, [&] { return create_image_array(self, self.popNextImage()); });
+            },
+            nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_DOC)
+        .def(
+            "acquireAccumulated",
+            [](CMMCore &self, long n, const std::string &mode) -> np_array {
+                return acquire_accumulated(self, n, parse_accumulate_mode(mode));
+            },
+            "n"_a, "mode"_a = "mean",
+            R"doc(Acquires `n` frames and returns their pixelwise mean, sum or maximum.
+
+
+Runs a sequence acquisition on the current camera and reduces each frame into
+an accumulator as it is popped from the circular buffer, so only the result is
+copied into Python.  `mode="mean"` returns float32, `"sum"` returns uint32
+(uint64 for 32-bit pixels or when `n` frames could overflow uint32) and
+`"max"` returns the camera's pixel type.  RGB images are reduced per channel.
+Raises RuntimeError if the sequence stops before `n` frames were acquired.
+)doc" RGIL("acquireAccumulated"))
+        .def(
+            "setFrameCorrection",
+            [](CMMCore &self, const std::string &cameraLabel,
+               std::optional<nb::ndarray<const float, nb::ndim<2>, nb::c_contig, nb::device::cpu>> dark,
+               std::optional<nb::ndarray<const float, nb::ndim<2>, nb::c_contig, nb::device::cpu>> flat,
+               const std::vector<std::tuple<unsigned, unsigned>> &hotPixels,
+               const std::string &dtype) {
+                if (!dark && !flat)
+                    throw std::invalid_argument("A dark and/or flat frame is required");
+                if (dtype != "float32" && dtype != "native")
+                    throw std::invalid_argument("dtype must be 'float32' or 'native', not '" +
+                                                dtype + "'");
+                auto c = std::make_shared<FrameCorrection>();
+                const auto &shaped = dark ? *dark : *flat;
+                c->height = static_cast<unsigned>(shaped.shape(0));
+                c->width = static_cast<unsigned>(shaped.shape(1));
+                for (const auto *map : {dark ? &*dark : nullptr, flat ? &*flat : nullptr})
+                    if (map && (map->shape(0) != c->height || map->shape(1) != c->width))
+                        throw std::invalid_argument("dark and flat must have the same shape");
+                size_t count = size_t(c->width) * c->height;
+                if (dark) {
+                    auto *values = static_cast<const float *>(dark->data());
+                    c->dark.assign(values, values + count);
+                }
+                if (flat) {
+                    // Normalize the dark-subtracted flat to its mean over valid pixels.
+                    auto *values = static_cast<const float *>(flat->data());
+                    std::vector<float> signal(values, values + count);
+                    double sum = 0;
+                    size_t valid = 0;
+                    for (size_t i = 0; i < count; ++i) {
+                        if (dark)
+                            signal[i] -= c->dark[i];
+                        if (signal[i] > 0)
+                            sum += signal[i], ++valid;
+                    }
+                    if (valid == 0)
+                        throw std::invalid_argument("flat has no pixels brighter than dark");
+                    float mean = static_cast<float>(sum / valid);
+                    c->gain.resize(count);
+                    for (size_t i = 0; i < count; ++i)
+                        c->gain[i] = signal[i] > 0 ? mean / signal[i] : 1.0f;
+                }
+                for (const auto &[row, col] : hotPixels) {
+                    if (row >= c->height || col >= c->width)
+                        throw std::invalid_argument("Hot pixel (" + std::to_string(row) + ", " +
+                                                    std::to_string(col) +
+                                                    ") is outside the image");
+                    c->hotPixels.push_back(size_t(row) * c->width + col);
+                }
+                c->nativeOutput = dtype == "native";
+                core_extensions(self).frameCorrections.set(cameraLabel, std::move(c));
+            },
+            "cameraLabel"_a, "dark"_a = nb::none(), "flat"_a = nb::none(),
+            "hotPixels"_a = std::vector<std::tuple<unsigned, unsigned>>(),
+            "dtype"_a = "float32",
+            R"doc(Registers a correction applied to every image of a camera.
+
+
+Images retrieved with getImage, getLastImage, popNextImage and their metadata
+variants become `(raw - dark) * mean(flat - dark) / (flat - dark)`, computed
+while the frame is copied out of the core.  `hotPixels` is a list of
+`(row, col)` positions replaced by the mean of their neighbours.  `dtype` is
+"float32" or "native" (the camera's pixel type, rounded and clipped).  The
+maps must match the image size; retrieving a differently sized image raises
+RuntimeError.  RGB images are corrected per color channel with the same maps.
+)doc")
+        .def(
+            "clearFrameCorrection",
+            [](CMMCore &self, const std::string &cameraLabel) {
+                core_extensions(self).frameCorrections.clear(cameraLabel);
+            },
+            "cameraLabel"_a = "",
+            "Removes the frame correction of a camera, or of all cameras if no label is given.")
+        .def(
+            "getFrameCorrectionCameras",
+            [](CMMCore &self) { return core_extensions(self).frameCorrections.cameras(); },
+            "Returns the labels of cameras with a registered frame correction.")
+        .def(
+            "setSoftwareROI",
+            [](CMMCore &self, const std::string &cameraLabel,
+               const std::vector<std::tuple<unsigned, unsigned, unsigned, unsigned>> &rects) {
+                if (rects.empty())
+                    throw std::invalid_argument("At least one rectangle is required");
+                auto roi = std::make_shared<SoftwareROI>();
+                for (const auto &[x, y, width, height] : rects) {
+                    if (width == 0 || height == 0)
+                        throw std::invalid_argument("ROI width and height must be positive");
+                    roi->rects.push_back({x, y, width, height});
+                }
+                core_extensions(self).softwareROIs.set(cameraLabel, std::move(roi));
+            },
+            "cameraLabel"_a, "rects"_a,
+            R"doc(Sets `(x, y, width, height)` rectangles to copy out of a camera's images.
+
+
+getImageROIs, getLastImageROIs, popNextImageROIs and their metadata variants
+then return a list with one array per rectangle, copied out of the core's
+buffer in one pass (and corrected on the way, see `setFrameCorrection`).  The
+other image getters are not affected.  Coordinates are relative to the image
+as delivered by the camera; retrieving an image that does not contain a
+rectangle raises RuntimeError.
+)doc")
+        .def(
+            "setSoftwareROIFromMultiROI",
+            [gil = gil_policy_flag("setSoftwareROIFromMultiROI")](CMMCore &self) {
+                std::vector<unsigned> xs, ys, widths, heights;
+                std::string camera;
+                {
+                    gil_policy_scope release(gil);
+                    self.getMultiROI(xs, ys, widths, heights);
+                    camera = self.getCameraDevice();
+                }
+                if (xs.empty())
+                    throw std::runtime_error("The current camera has no multi-ROI set");
+                // The camera delivers the bounding box of all ROIs.
+                unsigned left = *std::min_element(xs.begin(), xs.end());
+                unsigned top = *std::min_element(ys.begin(), ys.end());
+                auto roi = std::make_shared<SoftwareROI>();
+                for (size_t i = 0; i < xs.size(); ++i)
+                    roi->rects.push_back({xs[i] - left, ys[i] - top, widths[i], heights[i]});
+                core_extensions(self).softwareROIs.set(camera, std::move(roi));
+            },
+            R"doc(Sets the software ROI of the current camera from its multi-ROI.
+
+
+Images of a camera with several hardware ROIs span their bounding box; this
+splits them into the individual ROIs (see `setSoftwareROI`).
+)doc")
+        .def(
+            "getSoftwareROI",
+            [](CMMCore &self, const std::string &cameraLabel) {
+                std::vector<std::tuple<unsigned, unsigned, unsigned, unsigned>> rects;
+                if (auto roi = core_extensions(self).softwareROIs.get(cameraLabel))
+                    for (const ImageRect &r : roi->rects)
+                        rects.emplace_back(r.x, r.y, r.width, r.height);
+                return rects;
+            },
+            "cameraLabel"_a, "Returns the software ROI rectangles of a camera (empty if none).")
+        .def(
+            "clearSoftwareROI",
+            [](CMMCore &self, const std::string &cameraLabel) {
+                core_extensions(self).softwareROIs.clear(cameraLabel);
+            },
+            "cameraLabel"_a = "",
+            "Removes the software ROI of a camera, or of all cameras if no label is given.")
+        .def(
+            "getImageROIs",
+            [](CMMCore &self) { return create_roi_arrays(self, self.getImage(), nullptr); },
+            "Returns the software ROIs of the snapped image as a list of arrays (see "
+            "`setSoftwareROI`)." RGIL("getImageROIs"))
+        .def(
+            "getLastImageROIs",
+            [](CMMCore &self) { return create_roi_arrays(self, self.getLastImage(), nullptr); },
+            "Returns the software ROIs of the last image in the circular buffer as a list of "
+            "arrays." RGIL("getLastImageROIs"))
+        .def(
+            "popNextImageROIs",
+            [](CMMCore &self) { return create_roi_arrays(self, self.popNextImage(), nullptr); },
+            "Pops the next image from the circular buffer and returns its software ROIs as a "
+            "list of arrays." RGIL("popNextImageROIs"))
+        .def(
+            "getLastImageROIsMD",
+            [](CMMCore &self) -> std::tuple<std::vector<np_array>, Metadata> {
+                Metadata md;
+                auto img = self.getLastImageMD(md);
+                return {create_roi_arrays(self, img, &md), md};
+            },
+            "Returns the software ROIs of the last image in the circular buffer and its "
+            "metadata." RGIL("getLastImageROIsMD"))
+        .def(
+            "popNextImageROIsMD",
+            [](CMMCore &self) -> std::tuple<std::vector<np_array>, Metadata> {
+                Metadata md;
+                auto img = self.popNextImageMD(md);
+                return {create_roi_arrays(self, img, &md), md};
+            },
+            "Pops the next image from the circular buffer and returns its software ROIs and "
+            "metadata." RGIL("popNextImageROIsMD"))
         // this is a new overload that returns both the image and the metadata
         // not present in the original C++ API
         .def(
@@ -1245,15 +5674,15 @@ MMCore will send notifications on internal events using this interface
                 auto img = self.getLastImageMD(md);
                 return {create_metadata_array(self, img, md), md};
             },
-            "Get the last image in the circular buffer, return as tuple of image and metadata" RGIL)
+            "Get the last image in the circular buffer, return as tuple of image and metadata" RGIL("getLastImageMD"))
         .def(
             "getLastImageMD",
             [](CMMCore &self, Metadata &md) -> np_array {
-                auto img = self.getLastImageMD(md);
-                return create_metadata_array(self, img, md);
+                return metadata_image(self, md,
+                                      [&](Metadata &m) { return self.getLastImageMD(m); });
             },
             "md"_a,
-            "Get the last image in the circular buffer, store metadata in the provided object" RGIL)
+            "Get the last image in the circular buffer, store metadata in the provided object" RGIL("getLastImageMD"))
         .def(
             "getLastImageMD",
             [](CMMCore &self,
@@ -1266,18 +5695,61 @@ MMCore will send notifications on internal events using this interface
             "channel"_a,
             "slice"_a,
             "Get the last image in the circular buffer for a specific channel and slice, return"
-            "as tuple of image and metadata" RGIL)
+            "as tuple of image and metadata" RGIL("getLastImageMD"))
         .def(
             "getLastImageMD",
             [](CMMCore &self, unsigned channel, unsigned slice, Metadata &md) -> np_array {
-                auto img = self.getLastImageMD(channel, slice, md);
-                return create_metadata_array(self, img, md);
+                return metadata_image(self, md, [&](Metadata &m) {
+                    return self.getLastImageMD(channel, slice, m);
+                });
             },
             "channel"_a,
             "slice"_a,
             "md"_a,
             "Get the last image in the circular buffer for a specific channel and slice, store "
-            "metadata in the provided object" RGIL)
+            "metadata in the provided object" RGIL("getLastImageMD"))
+        .def(
+            "getLastImageMD",
+            [](CMMCore &self, const std::string &framework) {
+                Metadata md;
+                nb::object img = framework_image(framework, [&] {
+                    void *pixels = self.getLastImageMD(md);
+                    return create_metadata_array(self, pixels, md);
+                });
+                return std::make_tuple(img, md);
+            },
+            nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_MD_DOC)
+        .def(
+            "getLastImageMD",
+            [](CMMCore &self, Metadata &md, const std::string &framework) {
+                return framework_image(framework, [&] {
+                    return metadata_image(self, md,
+                                          [&](Metadata &m) { return self.getLastImageMD(m); });
+                });
+            },
+            "md"_a, nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_DOC)
+        .def(
+            "getLastImageMD",
+            [](CMMCore &self, unsigned channel, unsigned slice, const std::string &framework) {
+                Metadata md;
+                nb::object img = framework_image(framework, [&] {
+                    void *pixels = self.getLastImageMD(channel, slice, md);
+                    return create_metadata_array(self, pixels, md);
+                });
+                return std::make_tuple(img, md);
+            },
+            "channel"_a, "slice"_a, nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_MD_DOC)
+        .def(
+            "getLastImageMD",
+            [](CMMCore &self, unsigned channel, unsigned slice, Metadata &md,
+               const std::string &framework) {
+                return framework_image(framework, [&] {
+                    return metadata_image(self, md, [&](Metadata &m) {
+                        return self.getLastImageMD(channel, slice, m);
+                    });
+                });
+            },
+            "channel"_a, "slice"_a, "md"_a, nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_DOC)
 
         .def(
             "popNextImageMD",
@@ -1286,15 +5758,15 @@ MMCore will send notifications on internal events using this interface
                 auto img = self.popNextImageMD(md);
                 return {create_metadata_array(self, img, md), md};
             },
-            "Get the last image in the circular buffer, return as tuple of image and metadata" RGIL)
+            "Get the last image in the circular buffer, return as tuple of image and metadata" RGIL("popNextImageMD"))
         .def(
             "popNextImageMD",
             [](CMMCore &self, Metadata &md) -> np_array {
-                auto img = self.popNextImageMD(md);
-                return create_metadata_array(self, img, md);
+                return metadata_image(self, md,
+                                      [&](Metadata &m) { return self.popNextImageMD(m); });
             },
             "md"_a,
-            "Get the last image in the circular buffer, store metadata in the provided object" RGIL)
+            "Get the last image in the circular buffer, store metadata in the provided object" RGIL("popNextImageMD"))
         .def(
             "popNextImageMD",
             [](CMMCore &self,
@@ -1307,18 +5779,61 @@ MMCore will send notifications on internal events using this interface
             "channel"_a,
             "slice"_a,
             "Get the last image in the circular buffer for a specific channel and slice, return"
-            "as tuple of image and metadata" RGIL)
+            "as tuple of image and metadata" RGIL("popNextImageMD"))
         .def(
             "popNextImageMD",
             [](CMMCore &self, unsigned channel, unsigned slice, Metadata &md) -> np_array {
-                auto img = self.popNextImageMD(channel, slice, md);
-                return create_metadata_array(self, img, md);
+                return metadata_image(self, md, [&](Metadata &m) {
+                    return self.popNextImageMD(channel, slice, m);
+                });
             },
             "channel"_a,
             "slice"_a,
             "md"_a,
             "Get the last image in the circular buffer for a specific channel and slice, store "
-            "metadata in the provided object" RGIL)
+            "metadata in the provided object" RGIL("popNextImageMD"))
+        .def(
+            "popNextImageMD",
+            [](CMMCore &self, const std::string &framework) {
+                Metadata md;
+                nb::object img = framework_image(framework, [&] {
+                    void *pixels = self.popNextImageMD(md);
+                    return create_metadata_array(self, pixels, md);
+                });
+                return std::make_tuple(img, md);
+            },
+            nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_MD_DOC)
+        .def(
+            "popNextImageMD",
+            [](CMMCore &self, Metadata &md, const std::string &framework) {
+                return framework_image(framework, [&] {
+                    return metadata_image(self, md,
+                                          [&](Metadata &m) { return self.popNextImageMD(m); });
+                });
+            },
+            "md"_a, nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_DOC)
+        .def(
+            "popNextImageMD",
+            [](CMMCore &self, unsigned channel, unsigned slice, const std::string &framework) {
+                Metadata md;
+                nb::object img = framework_image(framework, [&] {
+                    void *pixels = self.popNextImageMD(channel, slice, md);
+                    return create_metadata_array(self, pixels, md);
+                });
+                return std::make_tuple(img, md);
+            },
+            "channel"_a, "slice"_a, nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_MD_DOC)
+        .def(
+            "popNextImageMD",
+            [](CMMCore &self, unsigned channel, unsigned slice, Metadata &md,
+               const std::string &framework) {
+                return framework_image(framework, [&] {
+                    return metadata_image(self, md, [&](Metadata &m) {
+                        return self.popNextImageMD(channel, slice, m);
+                    });
+                });
+            },
+            "channel"_a, "slice"_a, "md"_a, nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_DOC)
 
         .def(
             "getNBeforeLastImageMD",
@@ -1330,140 +5845,214 @@ MMCore will send notifications on internal events using this interface
             "n"_a,
             "Get the nth image before the last image in the circular buffer and return it as a "
             "tuple "
-            "of image and metadata" RGIL)
+            "of image and metadata" RGIL("getNBeforeLastImageMD"))
         .def(
             "getNBeforeLastImageMD",
             [](CMMCore &self, unsigned long n, Metadata &md) -> np_array {
-                auto img = self.getNBeforeLastImageMD(n, md);
-                return create_metadata_array(self, img, md);
+                return metadata_image(self, md, [&](Metadata &m) {
+                    return self.getNBeforeLastImageMD(n, m);
+                });
             },
             "n"_a,
             "md"_a,
             "Get the nth image before the last image in the circular buffer and store the "
             "metadata "
-            "in the provided object" RGIL)
+            "in the provided object" RGIL("getNBeforeLastImageMD"))
+        .def(
+            "getNBeforeLastImageMD",
+            [](CMMCore &self, unsigned long n, const std::string &framework) {
+                Metadata md;
+                nb::object img = framework_image(framework, [&] {
+                    void *pixels = self.getNBeforeLastImageMD(n, md);
+                    return create_metadata_array(self, pixels, md);
+                });
+                return std::make_tuple(img, md);
+            },
+            "n"_a, nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_MD_DOC)
+        .def(
+            "getNBeforeLastImageMD",
+            [](CMMCore &self, unsigned long n, Metadata &md, const std::string &framework) {
+                return framework_image(framework, [&] {
+                    return metadata_image(self, md, [&](Metadata &m) {
+                        return self.getNBeforeLastImageMD(n, m);
+                    });
+                });
+            },
+            "n"_a, "md"_a, nb::kw_only(), "framework"_a, FRAMEWORK_IMAGE_DOC)
 
         // Circular Buffer Methods
-        .def("getRemainingImageCount", &CMMCore::getRemainingImageCount RGIL)
-        .def("getBufferTotalCapacity", &CMMCore::getBufferTotalCapacity RGIL)
-        .def("getBufferFreeCapacity", &CMMCore::getBufferFreeCapacity RGIL)
-        .def("isBufferOverflowed", &CMMCore::isBufferOverflowed RGIL)
+        .def("getRemainingImageCount", &CMMCore::getRemainingImageCount RGIL("getRemainingImageCount"))
+        .def("getBufferTotalCapacity", &CMMCore::getBufferTotalCapacity RGIL("getBufferTotalCapacity"))
+        .def("getBufferFreeCapacity", &CMMCore::getBufferFreeCapacity RGIL("getBufferFreeCapacity"))
+        .def("isBufferOverflowed", &CMMCore::isBufferOverflowed RGIL("isBufferOverflowed"))
         .def("setCircularBufferMemoryFootprint",
              &CMMCore::setCircularBufferMemoryFootprint,
-             "sizeMB"_a RGIL)
-        .def("getCircularBufferMemoryFootprint", &CMMCore::getCircularBufferMemoryFootprint RGIL)
-        .def("initializeCircularBuffer", &CMMCore::initializeCircularBuffer RGIL)
-        .def("clearCircularBuffer", &CMMCore::clearCircularBuffer RGIL)
+             "sizeMB"_a RGIL("setCircularBufferMemoryFootprint"))
+        .def("getCircularBufferMemoryFootprint", &CMMCore::getCircularBufferMemoryFootprint RGIL("getCircularBufferMemoryFootprint"))
+        .def("autoSizeCircularBuffer", &auto_size_circular_buffer, "bufferSeconds"_a = 1.0,
+             "frameRate"_a = 0.0, "maxMemoryFraction"_a = 0.25,
+             R"doc(Sizes the circular buffer for the current camera and returns the size in MB.
+
+
+The buffer is made large enough for `bufferSeconds` of frames (all camera
+channels) at `frameRate` frames per second, which defaults to 1 / exposure,
+but no larger than `maxMemoryFraction` of the physical memory currently
+available.  Call again after changing the camera, ROI, binning or exposure.
+)doc" RGIL("autoSizeCircularBuffer"))
+        .def("initializeCircularBuffer", &CMMCore::initializeCircularBuffer RGIL("initializeCircularBuffer"))
+        .def("clearCircularBuffer", &CMMCore::clearCircularBuffer RGIL("clearCircularBuffer"))
 
         // Exposure Sequence Methods
-        .def("isExposureSequenceable", &CMMCore::isExposureSequenceable, "cameraLabel"_a RGIL)
-        .def("startExposureSequence", &CMMCore::startExposureSequence, "cameraLabel"_a RGIL)
-        .def("stopExposureSequence", &CMMCore::stopExposureSequence, "cameraLabel"_a RGIL)
+        .def("isExposureSequenceable", &CMMCore::isExposureSequenceable, "cameraLabel"_a RGIL("isExposureSequenceable"))
+        .def("startExposureSequence", &CMMCore::startExposureSequence, "cameraLabel"_a RGIL("startExposureSequence"))
+        .def("stopExposureSequence", &CMMCore::stopExposureSequence, "cameraLabel"_a RGIL("stopExposureSequence"))
         .def("getExposureSequenceMaxLength",
              &CMMCore::getExposureSequenceMaxLength,
-             "cameraLabel"_a RGIL)
+             "cameraLabel"_a RGIL("getExposureSequenceMaxLength"))
         .def("loadExposureSequence",
              &CMMCore::loadExposureSequence,
              "cameraLabel"_a,
-             "exposureSequence_ms"_a RGIL)
+             "exposureSequence_ms"_a RGIL("loadExposureSequence"))
 
         // Autofocus Methods
-        .def("getLastFocusScore", &CMMCore::getLastFocusScore RGIL)
-        .def("getCurrentFocusScore", &CMMCore::getCurrentFocusScore RGIL)
-        .def("enableContinuousFocus", &CMMCore::enableContinuousFocus, "enable"_a RGIL)
-        .def("isContinuousFocusEnabled", &CMMCore::isContinuousFocusEnabled RGIL)
-        .def("isContinuousFocusLocked", &CMMCore::isContinuousFocusLocked RGIL)
-        .def("isContinuousFocusDrive", &CMMCore::isContinuousFocusDrive, "stageLabel"_a RGIL)
-        .def("fullFocus", &CMMCore::fullFocus RGIL)
-        .def("incrementalFocus", &CMMCore::incrementalFocus RGIL)
-        .def("setAutoFocusOffset", &CMMCore::setAutoFocusOffset, "offset"_a RGIL)
-        .def("getAutoFocusOffset", &CMMCore::getAutoFocusOffset RGIL)
+        .def("getLastFocusScore", &CMMCore::getLastFocusScore RGIL("getLastFocusScore"))
+        .def("getCurrentFocusScore", &CMMCore::getCurrentFocusScore RGIL("getCurrentFocusScore"))
+        .def("enableContinuousFocus", &CMMCore::enableContinuousFocus, "enable"_a RGIL("enableContinuousFocus"))
+        .def("isContinuousFocusEnabled", &CMMCore::isContinuousFocusEnabled RGIL("isContinuousFocusEnabled"))
+        .def("isContinuousFocusLocked", &CMMCore::isContinuousFocusLocked RGIL("isContinuousFocusLocked"))
+        .def("isContinuousFocusDrive", &CMMCore::isContinuousFocusDrive, "stageLabel"_a RGIL("isContinuousFocusDrive"))
+        .def("fullFocus", &CMMCore::fullFocus RGIL("fullFocus"))
+        .def("incrementalFocus", &CMMCore::incrementalFocus RGIL("incrementalFocus"))
+        .def("setAutoFocusOffset", &CMMCore::setAutoFocusOffset, "offset"_a RGIL("setAutoFocusOffset"))
+        .def("getAutoFocusOffset", &CMMCore::getAutoFocusOffset RGIL("getAutoFocusOffset"))
+        .def(
+            "softwareAutofocus",
+            [](CMMCore &self, std::vector<double> positions, const std::string &metric,
+               std::string focusStage, bool useSequence, bool moveToBest) {
+                FocusSearch search =
+                    software_autofocus(self, std::move(positions), parse_focus_metric(metric),
+                                       std::move(focusStage), useSequence, moveToBest);
+                nb::gil_scoped_acquire gil;
+                nb::dict result;
+                result["bestPosition"] = search.bestPosition;
+                result["positions"] = owned_array(std::move(search.positions));
+                result["scores"] = owned_array(std::move(search.scores));
+                result["sequenced"] = search.sequenced;
+                return result;
+            },
+            "positions"_a, "metric"_a = "brenner", "focusStage"_a = "",
+            "useSequence"_a = false, "moveToBest"_a = true,
+            R"doc(Finds the sharpest of `positions` of a focus stage without an autofocus device.
+
+
+An image is acquired at each position and scored with `metric` ("brenner",
+"laplacian" or "variance", see `focusScore`) directly from the core's buffer.
+By default the stage is stepped and an image snapped per position.  With
+`useSequence=True` and a sequenceable stage, all positions are instead
+acquired with one stage sequence and sequence acquisition; only use this when
+the camera is wired to trigger the stage, or every frame is taken at the
+first position.
+The best position is refined by a parabolic fit around the peak and, if
+`moveToBest`, the stage is moved there.  `focusStage` defaults to the current
+focus device.  Returns `{"bestPosition", "positions", "scores", "sequenced"}`.
+)doc" RGIL("softwareAutofocus"))
 
         // State Device Control Methods
-        .def("setState", &CMMCore::setState, "stateDeviceLabel"_a, "state"_a RGIL)
-        .def("getState", &CMMCore::getState, "stateDeviceLabel"_a RGIL)
-        .def("getNumberOfStates", &CMMCore::getNumberOfStates, "stateDeviceLabel"_a RGIL)
-        .def("setStateLabel", &CMMCore::setStateLabel, "stateDeviceLabel"_a, "stateLabel"_a RGIL)
-        .def("getStateLabel", &CMMCore::getStateLabel, "stateDeviceLabel"_a RGIL)
+        .def("setState", &CMMCore::setState, "stateDeviceLabel"_a, "state"_a RGIL("setState"))
+        .def("getState", &CMMCore::getState, "stateDeviceLabel"_a RGIL("getState"))
+        .def("getNumberOfStates", &CMMCore::getNumberOfStates, "stateDeviceLabel"_a RGIL("getNumberOfStates"))
+        .def("setStateLabel", &CMMCore::setStateLabel, "stateDeviceLabel"_a, "stateLabel"_a RGIL("setStateLabel"))
+        .def("getStateLabel", &CMMCore::getStateLabel, "stateDeviceLabel"_a RGIL("getStateLabel"))
         .def("defineStateLabel",
              &CMMCore::defineStateLabel,
              "stateDeviceLabel"_a,
              "state"_a,
-             "stateLabel"_a RGIL)
-        .def("getStateLabels", &CMMCore::getStateLabels, "stateDeviceLabel"_a RGIL)
+             "stateLabel"_a RGIL("defineStateLabel"))
+        .def("getStateLabels", &CMMCore::getStateLabels, "stateDeviceLabel"_a RGIL("getStateLabels"))
         .def("getStateFromLabel",
              &CMMCore::getStateFromLabel,
              "stateDeviceLabel"_a,
-             "stateLabel"_a RGIL)
+             "stateLabel"_a RGIL("getStateFromLabel"))
 
         // Stage Control Methods
         .def("setPosition",
              nb::overload_cast<const char *, double>(&CMMCore::setPosition),
              "stageLabel"_a,
-             "position"_a RGIL)
-        .def("setPosition", nb::overload_cast<double>(&CMMCore::setPosition), "position"_a RGIL)
+             "position"_a RGIL("setPosition"))
+        .def("setPosition", nb::overload_cast<double>(&CMMCore::setPosition), "position"_a RGIL("setPosition"))
         .def("getPosition",
              nb::overload_cast<const char *>(&CMMCore::getPosition),
-             "stageLabel"_a RGIL)
-        .def("getPosition", nb::overload_cast<>(&CMMCore::getPosition) RGIL)
+             "stageLabel"_a RGIL("getPosition"))
+        .def("getPosition", nb::overload_cast<>(&CMMCore::getPosition) RGIL("getPosition"))
         .def("setRelativePosition",
              nb::overload_cast<const char *, double>(&CMMCore::setRelativePosition),
              "stageLabel"_a,
-             "d"_a RGIL)
+             "d"_a RGIL("setRelativePosition"))
         .def("setRelativePosition",
              nb::overload_cast<double>(&CMMCore::setRelativePosition),
-             "d"_a RGIL)
-        .def("setOrigin", nb::overload_cast<const char *>(&CMMCore::setOrigin), "stageLabel"_a RGIL)
-        .def("setOrigin", nb::overload_cast<>(&CMMCore::setOrigin) RGIL)
+             "d"_a RGIL("setRelativePosition"))
+        .def("setOrigin", nb::overload_cast<const char *>(&CMMCore::setOrigin), "stageLabel"_a RGIL("setOrigin"))
+        .def("setOrigin", nb::overload_cast<>(&CMMCore::setOrigin) RGIL("setOrigin"))
         .def("setAdapterOrigin",
              nb::overload_cast<const char *, double>(&CMMCore::setAdapterOrigin),
              "stageLabel"_a,
-             "newZUm"_a RGIL)
+             "newZUm"_a RGIL("setAdapterOrigin"))
         .def("setAdapterOrigin",
              nb::overload_cast<double>(&CMMCore::setAdapterOrigin),
-             "newZUm"_a RGIL)
+             "newZUm"_a RGIL("setAdapterOrigin"))
 
         // Focus Direction Methods
-        .def("setFocusDirection", &CMMCore::setFocusDirection, "stageLabel"_a, "sign"_a RGIL)
-        .def("getFocusDirection", &CMMCore::getFocusDirection, "stageLabel"_a RGIL)
+        .def("setFocusDirection", &CMMCore::setFocusDirection, "stageLabel"_a, "sign"_a RGIL("setFocusDirection"))
+        .def("getFocusDirection", &CMMCore::getFocusDirection, "stageLabel"_a RGIL("getFocusDirection"))
 
-        .def("isStageUsingCallbacks", &CMMCore::isStageUsingCallbacks, "stageLabel"_a RGIL)
+        .def("isStageUsingCallbacks", &CMMCore::isStageUsingCallbacks, "stageLabel"_a RGIL("isStageUsingCallbacks"))
 
         // Stage Sequence Methods
-        .def("isStageSequenceable", &CMMCore::isStageSequenceable, "stageLabel"_a RGIL)
-        .def("isStageLinearSequenceable", &CMMCore::isStageLinearSequenceable, "stageLabel"_a RGIL)
-        .def("startStageSequence", &CMMCore::startStageSequence, "stageLabel"_a RGIL)
-        .def("stopStageSequence", &CMMCore::stopStageSequence, "stageLabel"_a RGIL)
-        .def("getStageSequenceMaxLength", &CMMCore::getStageSequenceMaxLength, "stageLabel"_a RGIL)
+        .def("isStageSequenceable", &CMMCore::isStageSequenceable, "stageLabel"_a RGIL("isStageSequenceable"))
+        .def("isStageLinearSequenceable", &CMMCore::isStageLinearSequenceable, "stageLabel"_a RGIL("isStageLinearSequenceable"))
+        .def("startStageSequence", &CMMCore::startStageSequence, "stageLabel"_a RGIL("startStageSequence"))
+        .def("stopStageSequence", &CMMCore::stopStageSequence, "stageLabel"_a RGIL("stopStageSequence"))
+        .def("getStageSequenceMaxLength", &CMMCore::getStageSequenceMaxLength, "stageLabel"_a RGIL("getStageSequenceMaxLength"))
+        .def(
+            "loadStageSequence",
+            [](CMMCore &self, const char *stageLabel, position_array positionSequence) {
+                long maxLength = self.getStageSequenceMaxLength(stageLabel);
+                self.loadStageSequence(stageLabel,
+                                       checked_sequence(positionSequence, maxLength,
+                                                        "positionSequence"));
+            },
+            "stageLabel"_a, "positionSequence"_a,
+            "Loads a stage sequence from a 1D float64 array, without converting it element by "
+            "element." RGIL("loadStageSequence"))
         .def("loadStageSequence",
              &CMMCore::loadStageSequence,
              "stageLabel"_a,
-             "positionSequence"_a RGIL)
+             "positionSequence"_a RGIL("loadStageSequence"))
         .def("setStageLinearSequence",
              &CMMCore::setStageLinearSequence,
              "stageLabel"_a,
              "dZ_um"_a,
-             "nSlices"_a RGIL)
+             "nSlices"_a RGIL("setStageLinearSequence"))
 
         // XY Stage Control Methods
         .def("setXYPosition",
              nb::overload_cast<const char *, double, double>(&CMMCore::setXYPosition),
              "xyStageLabel"_a,
              "x"_a,
-             "y"_a RGIL)
+             "y"_a RGIL("setXYPosition"))
         .def("setXYPosition",
              nb::overload_cast<double, double>(&CMMCore::setXYPosition),
              "x"_a,
-             "y"_a RGIL)
+             "y"_a RGIL("setXYPosition"))
         .def("setRelativeXYPosition",
              nb::overload_cast<const char *, double, double>(&CMMCore::setRelativeXYPosition),
              "xyStageLabel"_a,
              "dx"_a,
-             "dy"_a RGIL)
+             "dy"_a RGIL("setRelativeXYPosition"))
         .def("setRelativeXYPosition",
              nb::overload_cast<double, double>(&CMMCore::setRelativeXYPosition),
              "dx"_a,
-             "dy"_a RGIL)
+             "dy"_a RGIL("setRelativeXYPosition"))
 
         .def(
             "getXYPosition",
@@ -1472,59 +6061,74 @@ MMCore will send notifications on internal events using this interface
                 self.getXYPosition(xyStageLabel, x, y);
                 return {x, y};
             },
-            "xyStageLabel"_a RGIL)
+            "xyStageLabel"_a RGIL("getXYPosition"))
         .def("getXYPosition",
              [](CMMCore &self) -> std::tuple<double, double> {
                 double x, y;
                 self.getXYPosition(x, y);
                 return {x, y};
-             } RGIL)
+             } RGIL("getXYPosition"))
         .def("getXPosition",
              nb::overload_cast<const char *>(&CMMCore::getXPosition),
-             "xyStageLabel"_a RGIL)
+             "xyStageLabel"_a RGIL("getXPosition"))
         .def("getYPosition",
              nb::overload_cast<const char *>(&CMMCore::getYPosition),
-             "xyStageLabel"_a RGIL)
-        .def("getXPosition", nb::overload_cast<>(&CMMCore::getXPosition) RGIL)
-        .def("getYPosition", nb::overload_cast<>(&CMMCore::getYPosition) RGIL)
-        .def("stop", &CMMCore::stop, "xyOrZStageLabel"_a RGIL)
-        .def("home", &CMMCore::home, "xyOrZStageLabel"_a RGIL)
+             "xyStageLabel"_a RGIL("getYPosition"))
+        .def("getXPosition", nb::overload_cast<>(&CMMCore::getXPosition) RGIL("getXPosition"))
+        .def("getYPosition", nb::overload_cast<>(&CMMCore::getYPosition) RGIL("getYPosition"))
+        .def("stop", &CMMCore::stop, "xyOrZStageLabel"_a RGIL("stop"))
+        .def("home", &CMMCore::home, "xyOrZStageLabel"_a RGIL("home"))
         .def("setOriginXY",
              nb::overload_cast<const char *>(&CMMCore::setOriginXY),
-             "xyStageLabel"_a RGIL)
-        .def("setOriginXY", nb::overload_cast<>(&CMMCore::setOriginXY) RGIL)
+             "xyStageLabel"_a RGIL("setOriginXY"))
+        .def("setOriginXY", nb::overload_cast<>(&CMMCore::setOriginXY) RGIL("setOriginXY"))
         .def("setOriginX",
              nb::overload_cast<const char *>(&CMMCore::setOriginX),
-             "xyStageLabel"_a RGIL)
-        .def("setOriginX", nb::overload_cast<>(&CMMCore::setOriginX) RGIL)
+             "xyStageLabel"_a RGIL("setOriginX"))
+        .def("setOriginX", nb::overload_cast<>(&CMMCore::setOriginX) RGIL("setOriginX"))
         .def("setOriginY",
              nb::overload_cast<const char *>(&CMMCore::setOriginY),
-             "xyStageLabel"_a RGIL)
-        .def("setOriginY", nb::overload_cast<>(&CMMCore::setOriginY) RGIL)
+             "xyStageLabel"_a RGIL("setOriginY"))
+        .def("setOriginY", nb::overload_cast<>(&CMMCore::setOriginY) RGIL("setOriginY"))
         .def("setAdapterOriginXY",
              nb::overload_cast<const char *, double, double>(&CMMCore::setAdapterOriginXY),
              "xyStageLabel"_a,
              "newXUm"_a,
-             "newYUm"_a RGIL)
+             "newYUm"_a RGIL("setAdapterOriginXY"))
         .def("setAdapterOriginXY",
              nb::overload_cast<double, double>(&CMMCore::setAdapterOriginXY),
              "newXUm"_a,
-             "newYUm"_a RGIL)
+             "newYUm"_a RGIL("setAdapterOriginXY"))
 
-        .def("isXYStageUsingCallbacks", &CMMCore::isXYStageUsingCallbacks, "xyStageLabel"_a RGIL)
+        .def("isXYStageUsingCallbacks", &CMMCore::isXYStageUsingCallbacks, "xyStageLabel"_a RGIL("isXYStageUsingCallbacks"))
 
         // XY Stage Sequence Methods
-        .def("isXYStageSequenceable", &CMMCore::isXYStageSequenceable, "xyStageLabel"_a RGIL)
-        .def("startXYStageSequence", &CMMCore::startXYStageSequence, "xyStageLabel"_a RGIL)
-        .def("stopXYStageSequence", &CMMCore::stopXYStageSequence, "xyStageLabel"_a RGIL)
+        .def("isXYStageSequenceable", &CMMCore::isXYStageSequenceable, "xyStageLabel"_a RGIL("isXYStageSequenceable"))
+        .def("startXYStageSequence", &CMMCore::startXYStageSequence, "xyStageLabel"_a RGIL("startXYStageSequence"))
+        .def("stopXYStageSequence", &CMMCore::stopXYStageSequence, "xyStageLabel"_a RGIL("stopXYStageSequence"))
         .def("getXYStageSequenceMaxLength",
              &CMMCore::getXYStageSequenceMaxLength,
-             "xyStageLabel"_a RGIL)
+             "xyStageLabel"_a RGIL("getXYStageSequenceMaxLength"))
+        .def(
+            "loadXYStageSequence",
+            [](CMMCore &self, const char *xyStageLabel, position_array xSequence,
+               position_array ySequence) {
+                if (xSequence.shape(0) != ySequence.shape(0))
+                    throw std::invalid_argument(
+                        "xSequence and ySequence must have the same length");
+                long maxLength = self.getXYStageSequenceMaxLength(xyStageLabel);
+                self.loadXYStageSequence(xyStageLabel,
+                                         checked_sequence(xSequence, maxLength, "xSequence"),
+                                         checked_sequence(ySequence, maxLength, "ySequence"));
+            },
+            "xyStageLabel"_a, "xSequence"_a, "ySequence"_a,
+            "Loads an XY stage sequence from two 1D float64 arrays, without converting them "
+            "element by element." RGIL("loadXYStageSequence"))
         .def("loadXYStageSequence",
              &CMMCore::loadXYStageSequence,
              "xyStageLabel"_a,
              "xSequence"_a,
-             "ySequence"_a RGIL)
+             "ySequence"_a RGIL("loadXYStageSequence"))
 
         // Serial Port Control
         .def("setSerialProperties",
@@ -1535,78 +6139,233 @@ MMCore will send notifications on internal events using this interface
              "delayBetweenCharsMs"_a,
              "handshaking"_a,
              "parity"_a,
-             "stopBits"_a RGIL)
+             "stopBits"_a RGIL("setSerialProperties"))
         .def("setSerialPortCommand",
              &CMMCore::setSerialPortCommand,
              "portLabel"_a,
              "command"_a,
-             "term"_a RGIL)
-        .def("getSerialPortAnswer", &CMMCore::getSerialPortAnswer, "portLabel"_a, "term"_a RGIL)
-        .def("writeToSerialPort", &CMMCore::writeToSerialPort, "portLabel"_a, "data"_a RGIL)
+             "term"_a RGIL("setSerialPortCommand"))
+        .def("getSerialPortAnswer", &CMMCore::getSerialPortAnswer, "portLabel"_a, "term"_a RGIL("getSerialPortAnswer"))
+        .def("writeToSerialPort", &CMMCore::writeToSerialPort, "portLabel"_a, "data"_a RGIL("writeToSerialPort"))
+        .def(
+            "serialTransact",
+            [gil = gil_policy_flag("serialTransact")](CMMCore &self, const char *portLabel,
+                                                      const std::vector<nb::bytes> &commands,
+                                                      nb::bytes term, double timeout_ms) {
+                auto &buffers = core_extensions(self).serialBuffers;
+                std::string terminator(term.c_str(), term.size());
+                StrVec batch;
+                batch.reserve(commands.size());
+                for (const auto &command : commands)
+                    batch.emplace_back(command.c_str(), command.size());
+                std::vector<std::string> answers;
+                {
+                    gil_policy_scope release(gil);
+                    answers =
+                        serial_transact(self, buffers, portLabel, batch, terminator, timeout_ms);
+                }
+                nb::list result;
+                for (const auto &answer : answers)
+                    result.append(nb::bytes(answer.data(), answer.size()));
+                return result;
+            },
+            "portLabel"_a, "commands"_a, "term"_a, "timeout_ms"_a,
+            nb::sig("def serialTransact(self, portLabel: str, commands: list[bytes], term: bytes, "
+                    "timeout_ms: float) -> list[bytes]"),
+            R"doc(Sends a batch of commands and collects one answer per command.
+
+
+Each command is followed by `term`; the whole batch is written at once and the
+answers (each terminated by `term`, which is stripped) are read with the GIL
+released.  Raises CMMError if not all answers arrive within `timeout_ms`.
+)doc")
         .def("readFromSerialPort",
-            [](CMMCore &self, const char *portLabel) -> nb::bytes {
-                auto vec = self.readFromSerialPort(portLabel);
-                return nb::bytes(vec.data(), vec.size());
+            [gil = gil_policy_flag("readFromSerialPort")](CMMCore &self,
+                                                          const char *portLabel) -> nb::bytes {
+                auto &port = core_extensions(self).serialBuffers.port(portLabel);
+                std::string data;
+                {
+                    gil_policy_scope release(gil);
+                    std::lock_guard<std::mutex> lock(port.mutex);
+                    // Read before taking the leftovers of readSerialInto/readSerialUntil,
+                    // so they stay buffered if the read throws.
+                    auto vec = self.readFromSerialPort(portLabel);
+                    data.swap(port.pending);
+                    data.append(vec.data(), vec.size());
+                }
+                return nb::bytes(data.data(), data.size());
+            },
+            "portLabel"_a)
+        .def(
+            "readSerialInto",
+            [gil = gil_policy_flag("readSerialInto")](
+                CMMCore &self, const char *portLabel,
+                nb::ndarray<uint8_t, nb::ndim<1>, nb::c_contig, nb::device::cpu> buffer,
+                size_t minBytes, double timeout_ms) {
+                auto &buffers = core_extensions(self).serialBuffers;
+                gil_policy_scope release(gil);
+                return serial_read_into(self, buffers, portLabel,
+                                        static_cast<uint8_t *>(buffer.data()), buffer.shape(0),
+                                        minBytes, timeout_ms);
+            },
+            "portLabel"_a, "buffer"_a, "minBytes"_a, "timeout_ms"_a,
+            R"doc(Reads from a serial port directly into a writable buffer (e.g. a bytearray).
+
+
+Blocks, with the GIL released, until at least `minBytes` bytes have arrived or
+`timeout_ms` has elapsed, then also takes whatever else is already available,
+up to the size of `buffer`.  Returns the number of bytes written; it is less
+than `minBytes` only on timeout.
+)doc")
+        .def(
+            "readSerialUntil",
+            [gil = gil_policy_flag("readSerialUntil")](CMMCore &self, const char *portLabel,
+                                                       nb::bytes terminator, double timeout_ms) {
+                auto &buffers = core_extensions(self).serialBuffers;
+                std::string term(terminator.c_str(), terminator.size());
+                std::string answer;
+                {
+                    gil_policy_scope release(gil);
+                    answer = serial_read_until(self, buffers, portLabel, term, timeout_ms);
+                }
+                return nb::bytes(answer.data(), answer.size());
             },
-            "portLabel"_a RGIL)
+            "portLabel"_a, "terminator"_a, "timeout_ms"_a,
+            R"doc(Reads from a serial port up to and including `terminator`.
+
+
+Blocks with the GIL released.  Raises CMMError if the terminator has not
+arrived within `timeout_ms`; bytes received past the terminator (or before a
+timeout) are returned by the next read.
+)doc")
 
         // SLM Control
         // setSLMImage accepts a second argument (pixels) of either unsigned char* or unsigned
         // int*
         .def(
             "setSLMImage",
-            [](CMMCore &self,
-               const char *slmLabel,
-               const nb::ndarray<uint8_t> &pixels) -> void {
-                long expectedWidth = self.getSLMWidth(slmLabel);
-                long expectedHeight = self.getSLMHeight(slmLabel);
-                long bytesPerPixel = self.getSLMBytesPerPixel(slmLabel);
-                validate_slm_image(pixels, expectedWidth, expectedHeight, bytesPerPixel);
-
-                // Cast the numpy array to a pointer to unsigned char
-                self.setSLMImage(slmLabel, reinterpret_cast<unsigned char *>(pixels.data()));
+            [](CMMCore &self, const char *slmLabel, const slm_array &pixels) -> void {
+                SLMFrames frames = prepare_slm_frames(pixels, false, slm_format(self, slmLabel));
+                self.setSLMImage(slmLabel, frames.frames[0]);
             },
             "slmLabel"_a,
-            "pixels"_a RGIL)
+            "pixels"_a,
+            R"doc(Sets the SLM image from a (h, w) or (h, w, c) array.
+
+
+uint8, bool (mapped to 0/255) and float (intensities in [0, 1]) arrays with any
+strides are accepted.  Gray and RGB input is converted to BGRA for SLMs with 4
+bytes per pixel.  Arrays already in the device layout are passed without a copy.
+)doc" RGIL("setSLMImage"))
         .def("setSLMPixelsTo",
              nb::overload_cast<const char *, unsigned char>(&CMMCore::setSLMPixelsTo),
              "slmLabel"_a,
-             "intensity"_a RGIL)
+             "intensity"_a RGIL("setSLMPixelsTo"))
         .def("setSLMPixelsTo",
              nb::overload_cast<const char *, unsigned char, unsigned char, unsigned char>(
                  &CMMCore::setSLMPixelsTo),
              "slmLabel"_a,
              "red"_a,
              "green"_a,
-             "blue"_a RGIL)
-        .def("displaySLMImage", &CMMCore::displaySLMImage, "slmLabel"_a RGIL)
-        .def("setSLMExposure", &CMMCore::setSLMExposure, "slmLabel"_a, "exposure_ms"_a RGIL)
-        .def("getSLMExposure", &CMMCore::getSLMExposure, "slmLabel"_a RGIL)
-        .def("getSLMWidth", &CMMCore::getSLMWidth, "slmLabel"_a RGIL)
-        .def("getSLMHeight", &CMMCore::getSLMHeight, "slmLabel"_a RGIL)
-        .def("getSLMNumberOfComponents", &CMMCore::getSLMNumberOfComponents, "slmLabel"_a RGIL)
-        .def("getSLMBytesPerPixel", &CMMCore::getSLMBytesPerPixel, "slmLabel"_a RGIL)
+             "blue"_a RGIL("setSLMPixelsTo"))
+        .def("displaySLMImage", &CMMCore::displaySLMImage, "slmLabel"_a RGIL("displaySLMImage"))
+        .def(
+            "registerSLMPattern",
+            [gil = gil_policy_flag("registerSLMPattern")](CMMCore &self, const char *slmLabel,
+                                                          const slm_array &pixels) {
+                SLMPatternCache &cache = core_extensions(self).slmPatterns;
+                gil_policy_scope release(gil);
+                SLMFormat fmt = slm_format(self, slmLabel);
+                SLMFrames frames = prepare_slm_frames(pixels, false, fmt);
+                if (frames.storage.empty())
+                    frames.storage.assign(frames.frames[0], frames.frames[0] + fmt.frameBytes());
+                return cache.add(slmLabel, std::move(frames.storage));
+            },
+            "slmLabel"_a, "pixels"_a,
+            R"doc(Converts an SLM image (as accepted by `setSLMImage`) once and stores it.
+
+
+Returns a pattern id for `displaySLMPattern` and `loadSLMSequenceByIds`.  Stored
+patterns are not re-validated, so re-register them if the SLM geometry changes.
+)doc")
+        .def(
+            "displaySLMPattern",
+            [gil = gil_policy_flag("displaySLMPattern")](CMMCore &self, size_t patternId) {
+                SLMPatternCache &cache = core_extensions(self).slmPatterns;
+                gil_policy_scope release(gil);
+                auto pattern = cache.get(patternId);
+                const char *label = pattern->slmLabel.c_str();
+                self.setSLMImage(label, const_cast<unsigned char *>(pattern->pixels.data()));
+                self.displaySLMImage(label);
+            },
+            "patternId"_a, "Sets and displays a pattern stored with `registerSLMPattern`.")
+        .def(
+            "loadSLMSequenceByIds",
+            [gil = gil_policy_flag("loadSLMSequenceByIds")](CMMCore &self,
+                                                            const std::vector<size_t> &patternIds) {
+                SLMPatternCache &cache = core_extensions(self).slmPatterns;
+                gil_policy_scope release(gil);
+                std::vector<std::shared_ptr<const SLMPatternCache::Pattern>> patterns;
+                std::vector<unsigned char *> frames;
+                for (size_t id : patternIds) {
+                    patterns.push_back(cache.get(id));
+                    if (patterns.back()->slmLabel != patterns.front()->slmLabel)
+                        throw std::invalid_argument(
+                            "All patterns in a sequence must belong to the same SLM");
+                    frames.push_back(const_cast<unsigned char *>(patterns.back()->pixels.data()));
+                }
+                if (patterns.empty())
+                    throw std::invalid_argument("patternIds must not be empty");
+                self.loadSLMSequence(patterns.front()->slmLabel.c_str(), frames);
+            },
+            "patternIds"_a, "Loads an SLM sequence from patterns stored with `registerSLMPattern`.")
+        .def(
+            "unregisterSLMPattern",
+            [](CMMCore &self, size_t patternId) {
+                return core_extensions(self).slmPatterns.remove(patternId);
+            },
+            "patternId"_a,
+            "Frees a stored SLM pattern. Returns False if the id is unknown.")
+        .def(
+            "clearSLMPatterns",
+            [](CMMCore &self) { core_extensions(self).slmPatterns.clear(); },
+            "Frees all stored SLM patterns.")
+        .def("setSLMExposure", &CMMCore::setSLMExposure, "slmLabel"_a, "exposure_ms"_a RGIL("setSLMExposure"))
+        .def("getSLMExposure", &CMMCore::getSLMExposure, "slmLabel"_a RGIL("getSLMExposure"))
+        .def("getSLMWidth", &CMMCore::getSLMWidth, "slmLabel"_a RGIL("getSLMWidth"))
+        .def("getSLMHeight", &CMMCore::getSLMHeight, "slmLabel"_a RGIL("getSLMHeight"))
+        .def("getSLMNumberOfComponents", &CMMCore::getSLMNumberOfComponents, "slmLabel"_a RGIL("getSLMNumberOfComponents"))
+        .def("getSLMBytesPerPixel", &CMMCore::getSLMBytesPerPixel, "slmLabel"_a RGIL("getSLMBytesPerPixel"))
         // SLM Sequence
-        .def("getSLMSequenceMaxLength", &CMMCore::getSLMSequenceMaxLength, "slmLabel"_a RGIL)
-        .def("startSLMSequence", &CMMCore::startSLMSequence, "slmLabel"_a RGIL)
-        .def("stopSLMSequence", &CMMCore::stopSLMSequence, "slmLabel"_a RGIL)
+        .def("getSLMSequenceMaxLength", &CMMCore::getSLMSequenceMaxLength, "slmLabel"_a RGIL("getSLMSequenceMaxLength"))
+        .def("startSLMSequence", &CMMCore::startSLMSequence, "slmLabel"_a RGIL("startSLMSequence"))
+        .def("stopSLMSequence", &CMMCore::stopSLMSequence, "slmLabel"_a RGIL("stopSLMSequence"))
         .def(
             "loadSLMSequence",
-            [](CMMCore &self,
-               const char *slmLabel,
-               std::vector<nb::ndarray<uint8_t>> &imageSequence) -> void {
-                long expectedWidth = self.getSLMWidth(slmLabel);
-                long expectedHeight = self.getSLMHeight(slmLabel);
-                long bytesPerPixel = self.getSLMBytesPerPixel(slmLabel);
+            [](CMMCore &self, const char *slmLabel, const slm_array &pixels) -> void {
+                SLMFrames frames = prepare_slm_frames(pixels, true, slm_format(self, slmLabel));
+                self.loadSLMSequence(slmLabel, frames.frames);
+            },
+            "slmLabel"_a,
+            "pixels"_a,
+            "Loads an SLM sequence from a single (n, h, w) or (n, h, w, c) array, converted as "
+            "in `setSLMImage`." RGIL("loadSLMSequence"))
+        .def(
+            "loadSLMSequence",
+            [](CMMCore &self, const char *slmLabel, const std::vector<slm_array> &imageSequence)
+                -> void {
+                SLMFormat fmt = slm_format(self, slmLabel);
+                std::vector<SLMFrames> converted;
                 std::vector<unsigned char *> inputVector;
-                for (auto &image : imageSequence) {
-                    validate_slm_image(image, expectedWidth, expectedHeight, bytesPerPixel);
-                    inputVector.push_back(reinterpret_cast<unsigned char *>(image.data()));
+                converted.reserve(imageSequence.size());
+                for (const auto &image : imageSequence) {
+                    converted.push_back(prepare_slm_frames(image, false, fmt));
+                    inputVector.push_back(converted.back().frames[0]);
                 }
                 self.loadSLMSequence(slmLabel, inputVector);
             },
             "slmLabel"_a,
-            "pixels"_a RGIL)
+            "pixels"_a RGIL("loadSLMSequence"))
 
         // Galvo Control
         .def("pointGalvoAndFire",
@@ -1614,79 +6373,413 @@ MMCore will send notifications on internal events using this interface
              "galvoLabel"_a,
              "x"_a,
              "y"_a,
-             "pulseTime_us"_a RGIL)
+             "pulseTime_us"_a RGIL("pointGalvoAndFire"))
+        .def(
+            "fireGalvoPointSequence",
+            [gil = gil_policy_flag("fireGalvoPointSequence")](
+                CMMCore &self, const char *galvoLabel, point_array points, double pulseTime_us,
+                double interval_us) {
+                std::vector<double> startTimes;
+                {
+                    gil_policy_scope release(gil);
+                    startTimes =
+                        fire_galvo_points(self, galvoLabel, points, pulseTime_us, interval_us);
+                }
+                return owned_array(std::move(startTimes));
+            },
+            "galvoLabel"_a, "points"_a, "pulseTime_us"_a, "interval_us"_a = 0.0,
+            R"doc(Calls `pointGalvoAndFire` for each row of an (N, 2) float64 array.
+
+
+Point `i` is started `i * interval_us` after the first (or as soon as the
+previous one returns, if that is later).  Returns the actual start time of each
+point, in seconds relative to the first.
+)doc")
         .def("setGalvoSpotInterval",
              &CMMCore::setGalvoSpotInterval,
              "galvoLabel"_a,
-             "pulseTime_us"_a RGIL)
-        .def("setGalvoPosition", &CMMCore::setGalvoPosition, "galvoLabel"_a, "x"_a, "y"_a RGIL)
+             "pulseTime_us"_a RGIL("setGalvoSpotInterval"))
+        .def("setGalvoPosition", &CMMCore::setGalvoPosition, "galvoLabel"_a, "x"_a, "y"_a RGIL("setGalvoPosition"))
         .def("getGalvoPosition",
              [](CMMCore &self, const char *galvoLabel) -> std::tuple<double, double> {
                 double x, y;
                 self.getGalvoPosition(galvoLabel, x, y);
                 return std::make_tuple(x, y);
-             }, "galvoLabel"_a RGIL)
+             }, "galvoLabel"_a RGIL("getGalvoPosition"))
         .def("setGalvoIlluminationState",
              &CMMCore::setGalvoIlluminationState,
              "galvoLabel"_a,
-             "on"_a RGIL)
-        .def("getGalvoXRange", &CMMCore::getGalvoXRange, "galvoLabel"_a RGIL)
-        .def("getGalvoXMinimum", &CMMCore::getGalvoXMinimum, "galvoLabel"_a RGIL)
-        .def("getGalvoYRange", &CMMCore::getGalvoYRange, "galvoLabel"_a RGIL)
-        .def("getGalvoYMinimum", &CMMCore::getGalvoYMinimum, "galvoLabel"_a RGIL)
+             "on"_a RGIL("setGalvoIlluminationState"))
+        .def("getGalvoXRange", &CMMCore::getGalvoXRange, "galvoLabel"_a RGIL("getGalvoXRange"))
+        .def("getGalvoXMinimum", &CMMCore::getGalvoXMinimum, "galvoLabel"_a RGIL("getGalvoXMinimum"))
+        .def("getGalvoYRange", &CMMCore::getGalvoYRange, "galvoLabel"_a RGIL("getGalvoYRange"))
+        .def("getGalvoYMinimum", &CMMCore::getGalvoYMinimum, "galvoLabel"_a RGIL("getGalvoYMinimum"))
         .def("addGalvoPolygonVertex",
              &CMMCore::addGalvoPolygonVertex,
              "galvoLabel"_a,
              "polygonIndex"_a,
              "x"_a,
              "y"_a,
-             R"doc(Add a vertex to a galvo polygon.)doc" RGIL)
-        .def("deleteGalvoPolygons", &CMMCore::deleteGalvoPolygons, "galvoLabel"_a RGIL)
-        .def("loadGalvoPolygons", &CMMCore::loadGalvoPolygons, "galvoLabel"_a RGIL)
+             R"doc(Add a vertex to a galvo polygon.)doc" RGIL("addGalvoPolygonVertex"))
+        .def("deleteGalvoPolygons", &CMMCore::deleteGalvoPolygons, "galvoLabel"_a RGIL("deleteGalvoPolygons"))
+        .def("loadGalvoPolygons", &CMMCore::loadGalvoPolygons, "galvoLabel"_a RGIL("loadGalvoPolygons"))
         .def("setGalvoPolygonRepetitions",
              &CMMCore::setGalvoPolygonRepetitions,
              "galvoLabel"_a,
-             "repetitions"_a RGIL)
-        .def("runGalvoPolygons", &CMMCore::runGalvoPolygons, "galvoLabel"_a RGIL)
-        .def("runGalvoSequence", &CMMCore::runGalvoSequence, "galvoLabel"_a RGIL)
-        .def("getGalvoChannel", &CMMCore::getGalvoChannel, "galvoLabel"_a RGIL)
+             "repetitions"_a RGIL("setGalvoPolygonRepetitions"))
+        .def(
+            "loadGalvoPolygonsFromArrays",
+            [](CMMCore &self, const char *galvoLabel, point_array vertices,
+               offset_array polygonOffsets) {
+                load_galvo_polygons(self, galvoLabel, vertices, polygonOffsets);
+            },
+            "galvoLabel"_a, "vertices"_a, "polygonOffsets"_a,
+            R"doc(Replaces the galvo polygons with vertices from an (N, 2) float64 array.
+
+
+Polygon `i` consists of rows `polygonOffsets[i]` up to (not including)
+`polygonOffsets[i + 1]`; the last polygon runs to the end of `vertices`.  A
+trailing offset equal to N is accepted.  The polygons are then loaded into the
+device, as with `loadGalvoPolygons`.
+)doc" RGIL("loadGalvoPolygonsFromArrays"))
+        .def("runGalvoPolygons", &CMMCore::runGalvoPolygons, "galvoLabel"_a RGIL("runGalvoPolygons"))
+        .def("runGalvoSequence", &CMMCore::runGalvoSequence, "galvoLabel"_a RGIL("runGalvoSequence"))
+        .def("getGalvoChannel", &CMMCore::getGalvoChannel, "galvoLabel"_a RGIL("getGalvoChannel"))
         
         // PressurePump Control
-        .def("pressurePumpStop", &CMMCore::pressurePumpStop, "pumpLabel"_a RGIL)
-        .def("pressurePumpCalibrate", &CMMCore::pressurePumpCalibrate, "pumpLabel"_a RGIL)
-        .def("pressurePumpRequiresCalibration", &CMMCore::pressurePumpRequiresCalibration, "pumpLabel"_a RGIL)
-        .def("setPumpPressureKPa", &CMMCore::setPumpPressureKPa, "pumpLabel"_a, "pressure"_a RGIL)
-        .def("getPumpPressureKPa", &CMMCore::getPumpPressureKPa, "pumpLabel"_a RGIL)
+        .def("pressurePumpStop", &CMMCore::pressurePumpStop, "pumpLabel"_a RGIL("pressurePumpStop"))
+        .def("pressurePumpCalibrate", &CMMCore::pressurePumpCalibrate, "pumpLabel"_a RGIL("pressurePumpCalibrate"))
+        .def("pressurePumpRequiresCalibration", &CMMCore::pressurePumpRequiresCalibration, "pumpLabel"_a RGIL("pressurePumpRequiresCalibration"))
+        .def("setPumpPressureKPa", &CMMCore::setPumpPressureKPa, "pumpLabel"_a, "pressure"_a RGIL("setPumpPressureKPa"))
+        .def("getPumpPressureKPa", &CMMCore::getPumpPressureKPa, "pumpLabel"_a RGIL("getPumpPressureKPa"))
         
         // VolumetricPump control
-        .def("volumetricPumpStop", &CMMCore::volumetricPumpStop, "pumpLabel"_a RGIL)
-        .def("volumetricPumpHome", &CMMCore::volumetricPumpHome, "pumpLabel"_a RGIL)
-        .def("volumetricPumpRequiresHoming", &CMMCore::volumetricPumpRequiresHoming, "pumpLabel"_a RGIL)
-        .def("invertPumpDirection", &CMMCore::invertPumpDirection, "pumpLabel"_a, "invert"_a RGIL)
-        .def("isPumpDirectionInverted", &CMMCore::isPumpDirectionInverted, "pumpLabel"_a RGIL)
-        .def("setPumpVolume", &CMMCore::setPumpVolume, "pumpLabel"_a, "volume"_a RGIL)
-        .def("getPumpVolume", &CMMCore::getPumpVolume, "pumpLabel"_a RGIL)
-        .def("setPumpMaxVolume", &CMMCore::setPumpMaxVolume, "pumpLabel"_a, "volume"_a RGIL)
-        .def("getPumpMaxVolume", &CMMCore::getPumpMaxVolume, "pumpLabel"_a RGIL)
-        .def("setPumpFlowrate", &CMMCore::setPumpFlowrate, "pumpLabel"_a, "volume"_a RGIL)
-        .def("getPumpFlowrate", &CMMCore::getPumpFlowrate, "pumpLabel"_a RGIL)
-        .def("pumpStart", &CMMCore::pumpStart, "pumpLabel"_a RGIL)
-        .def("pumpDispenseDurationSeconds", &CMMCore::pumpDispenseDurationSeconds, "pumpLabel"_a, "seconds"_a RGIL)
-        .def("pumpDispenseVolumeUl", &CMMCore::pumpDispenseVolumeUl, "pumpLabel"_a, "microLiter"_a RGIL)
+        .def("volumetricPumpStop", &CMMCore::volumetricPumpStop, "pumpLabel"_a RGIL("volumetricPumpStop"))
+        .def("volumetricPumpHome", &CMMCore::volumetricPumpHome, "pumpLabel"_a RGIL("volumetricPumpHome"))
+        .def("volumetricPumpRequiresHoming", &CMMCore::volumetricPumpRequiresHoming, "pumpLabel"_a RGIL("volumetricPumpRequiresHoming"))
+        .def("invertPumpDirection", &CMMCore::invertPumpDirection, "pumpLabel"_a, "invert"_a RGIL("invertPumpDirection"))
+        .def("isPumpDirectionInverted", &CMMCore::isPumpDirectionInverted, "pumpLabel"_a RGIL("isPumpDirectionInverted"))
+        .def("setPumpVolume", &CMMCore::setPumpVolume, "pumpLabel"_a, "volume"_a RGIL("setPumpVolume"))
+        .def("getPumpVolume", &CMMCore::getPumpVolume, "pumpLabel"_a RGIL("getPumpVolume"))
+        .def("setPumpMaxVolume", &CMMCore::setPumpMaxVolume, "pumpLabel"_a, "volume"_a RGIL("setPumpMaxVolume"))
+        .def("getPumpMaxVolume", &CMMCore::getPumpMaxVolume, "pumpLabel"_a RGIL("getPumpMaxVolume"))
+        .def("setPumpFlowrate", &CMMCore::setPumpFlowrate, "pumpLabel"_a, "volume"_a RGIL("setPumpFlowrate"))
+        .def("getPumpFlowrate", &CMMCore::getPumpFlowrate, "pumpLabel"_a RGIL("getPumpFlowrate"))
+        .def("pumpStart", &CMMCore::pumpStart, "pumpLabel"_a RGIL("pumpStart"))
+        .def("pumpDispenseDurationSeconds", &CMMCore::pumpDispenseDurationSeconds, "pumpLabel"_a, "seconds"_a RGIL("pumpDispenseDurationSeconds"))
+        .def("pumpDispenseVolumeUl", &CMMCore::pumpDispenseVolumeUl, "pumpLabel"_a, "microLiter"_a RGIL("pumpDispenseVolumeUl"))
 
         // Device Discovery
-        .def("supportsDeviceDetection", &CMMCore::supportsDeviceDetection, "deviceLabel"_a RGIL)
-        .def("detectDevice", &CMMCore::detectDevice, "deviceLabel"_a RGIL)
+        .def("supportsDeviceDetection", &CMMCore::supportsDeviceDetection, "deviceLabel"_a RGIL("supportsDeviceDetection"))
+        .def("detectDevice", &CMMCore::detectDevice, "deviceLabel"_a RGIL("detectDevice"))
 
         // Hub and Peripheral Devices
-        .def("getParentLabel", &CMMCore::getParentLabel, "peripheralLabel"_a RGIL)
-        .def("setParentLabel", &CMMCore::setParentLabel, "deviceLabel"_a, "parentHubLabel"_a RGIL)
-        .def("getInstalledDevices", &CMMCore::getInstalledDevices, "hubLabel"_a RGIL)
+        .def("getParentLabel", &CMMCore::getParentLabel, "peripheralLabel"_a RGIL("getParentLabel"))
+        .def("setParentLabel", &CMMCore::setParentLabel, "deviceLabel"_a, "parentHubLabel"_a RGIL("setParentLabel"))
+        .def("getInstalledDevices", &CMMCore::getInstalledDevices, "hubLabel"_a RGIL("getInstalledDevices"))
         .def("getInstalledDeviceDescription",
              &CMMCore::getInstalledDeviceDescription,
              "hubLabel"_a,
-             "peripheralLabel"_a RGIL)
-        .def("getLoadedPeripheralDevices", &CMMCore::getLoadedPeripheralDevices, "hubLabel"_a RGIL)
+             "peripheralLabel"_a RGIL("getInstalledDeviceDescription"))
+        .def("getLoadedPeripheralDevices", &CMMCore::getLoadedPeripheralDevices, "hubLabel"_a RGIL("getLoadedPeripheralDevices"))
 
         ;
+
+    nb::class_<StageSequenceStream>(m, "StageSequenceStream", R"doc(
+Runs a stage sequence longer than the device limit as a series of chunks.
+
+
+Positions are split into chunks of at most `getStageSequenceMaxLength` (or
+`getXYStageSequenceMaxLength`) points.  Each call to `advance()` stops the
+running chunk, then loads and starts the next one; call it when the hardware
+has consumed the current chunk (e.g. after the corresponding images arrived).
+
+The stage is not sequencing while the next chunk is loaded, so triggers that
+arrive between `advance()` stopping one chunk and starting the next are lost.
+Pause the trigger source (e.g. end the camera sequence after each chunk's
+frames) across the call, or the positions will drift from the frames.
+`advance()` raises if the stage still reports busy with the current chunk,
+unless `force=True` is passed.
+)doc")
+        .def(nb::init<CMMCore &, std::string, const position_array &>(), "core"_a,
+             "stageLabel"_a, "positionSequence"_a, nb::keep_alive<1, 2>())
+        .def(nb::init<CMMCore &, std::string, const position_array &, const position_array &>(),
+             "core"_a, "xyStageLabel"_a, "xSequence"_a, "ySequence"_a, nb::keep_alive<1, 2>())
+        .def_prop_ro("chunkSize", &StageSequenceStream::chunkSize)
+        .def_prop_ro("chunkCount", &StageSequenceStream::chunkCount)
+        .def_prop_ro("currentChunk", &StageSequenceStream::currentChunk)
+        .def("advance", &StageSequenceStream::advance, "force"_a = false,
+             "Stops the running chunk and starts the next one. Returns False when all chunks "
+             "have run. Raises if the stage is still busy with the running chunk, unless "
+             "`force` is True." RGIL("StageSequenceStream.advance"))
+        .def("stop", &StageSequenceStream::stop, "Stops the running chunk." RGIL("StageSequenceStream.stop"));
+
+    nb::class_<StageTelemetry>(m, "StageTelemetry", R"doc(
+Records stage positions from a background thread at a fixed rate.
+
+
+Samples are timestamped with a monotonic clock (seconds since construction or
+the last `clear()`) and kept in a ring buffer of `capacity` samples, so the
+oldest samples are dropped once it is full.
+)doc")
+        .def(nb::init<CMMCore &, std::string, std::string, size_t>(), "core"_a,
+             "xyStage"_a = "", "zStage"_a = "", "capacity"_a = 100000, nb::keep_alive<1, 2>())
+        .def("start", &StageTelemetry::start, "intervalMs"_a,
+             "Starts polling every `intervalMs` milliseconds (restarting if already running)." RGIL("StageTelemetry.start"))
+        .def("stop", &StageTelemetry::stop, "Stops polling; buffered samples are kept." RGIL("StageTelemetry.stop"))
+        .def("isRunning", &StageTelemetry::isRunning)
+        .def("clear", &StageTelemetry::clear, "Discards all samples and resets the time base." RGIL("StageTelemetry.clear"))
+        .def("__len__", &StageTelemetry::size)
+        .def(
+            "getSamples",
+            [](const StageTelemetry &self) {
+                std::vector<StageTelemetry::Sample> samples;
+                {
+                    nb::gil_scoped_release release;
+                    samples = self.samples();
+                }
+                std::vector<double> t, x, y, z;
+                for (auto *v : {&t, &x, &y, &z})
+                    v->reserve(samples.size());
+                for (const auto &s : samples) {
+                    t.push_back(s.t);
+                    x.push_back(s.x);
+                    y.push_back(s.y);
+                    z.push_back(s.z);
+                }
+                return std::make_tuple(owned_array(std::move(t)),
+                                       owned_array(std::move(x)),
+                                       owned_array(std::move(y)),
+                                       owned_array(std::move(z)));
+            },
+            R"doc(Returns the buffered samples, oldest first, as float64 arrays `(t, x, y, z)`.
+
+
+Axes that are not recorded are NaN.
+)doc");
+
+    nb::class_<SharedFramePublisher>(m, "SharedFramePublisher", R"doc(
+Publishes acquired frames into a named POSIX shared-memory ring.
+
+
+Once started, a background thread pops every frame from the circular buffer
+(so nothing else should pop images) and copies it into one of `slotCount`
+slots of `slotBytes` bytes (default: the current camera's image size).
+`SharedFrameReader` objects in any process on the machine can then read the
+frames without copying.  The segment is removed when the publisher is
+deleted.  Creating a publisher raises RuntimeError if a segment with the same
+name exists, unless its publisher is gone (e.g. its process crashed), in which
+case it is replaced.  Not available on Windows.
+)doc")
+        .def(nb::init<CMMCore &, std::string, uint32_t, uint64_t>(), "core"_a, "name"_a,
+             "slotCount"_a = 64, "slotBytes"_a = 0, nb::keep_alive<1, 2>())
+        .def("start", &SharedFramePublisher::start,
+             "Starts publishing frames from the circular buffer." RGIL("SharedFramePublisher.start"))
+        .def("stop", &SharedFramePublisher::stop, "Stops publishing." RGIL("SharedFramePublisher.stop"))
+        .def("isRunning", &SharedFramePublisher::isRunning,
+             "False if stopped, or if publishing failed (see `lastError`).")
+        .def_prop_ro("lastError", &SharedFramePublisher::lastError,
+                     "Error that stopped publishing, or an empty string.")
+        .def_prop_ro("name", &SharedFramePublisher::name)
+        .def_prop_ro("slotCount", &SharedFramePublisher::slotCount)
+        .def_prop_ro("slotBytes", &SharedFramePublisher::slotBytes)
+        .def_prop_ro("framesPublished", &SharedFramePublisher::framesPublished);
+
+    nb::class_<SharedFrameReader>(m, "SharedFrameReader", R"doc(
+Reads frames published by a `SharedFramePublisher`, possibly in another process.
+
+
+Frames are returned as `(image, frameNumber)` with `image` a read-only,
+zero-copy view of the shared memory, shaped like `popNextImage()`'s result.
+The view's contents are replaced once the publisher wraps around the ring, so
+check `isValid(frameNumber)` after processing (or copy the image) if the
+reader may fall more than `slotCount` frames behind.  Frames the reader was
+too slow to see are counted in `dropped`.
+)doc")
+        .def(nb::init<std::string>(), "name"_a)
+        .def(
+            "next",
+            [](SharedFrameReader &self, double timeout_ms) -> nb::object {
+                std::optional<SharedFrameReader::Frame> frame;
+                {
+                    nb::gil_scoped_release release;
+                    frame = self.next(timeout_ms);
+                }
+                if (!frame)
+                    return nb::none();
+                return nb::make_tuple(shared_frame_view(*frame, nb::find(&self)),
+                                      frame->number);
+            },
+            "timeout_ms"_a = -1.0,
+            nb::sig("def next(self, timeout_ms: float = -1.0) -> "
+                    "tuple[numpy.typing.NDArray[typing.Any], int] | None"),
+            R"doc(Waits for the next unread frame, in publication order.
+
+
+Returns None on timeout (a negative timeout waits indefinitely) or when the
+publisher is gone and all frames were read.  The first call returns the first
+frame published after the reader was created.
+)doc")
+        .def(
+            "latest",
+            [](SharedFrameReader &self) -> nb::object {
+                auto frame = self.latest();
+                if (!frame)
+                    return nb::none();
+                return nb::make_tuple(shared_frame_view(*frame, nb::find(&self)),
+                                      frame->number);
+            },
+            nb::sig("def latest(self) -> tuple[numpy.typing.NDArray[typing.Any], int] | None"),
+            "Returns the most recent frame (or None) without changing the read position.")
+        .def("isValid", &SharedFrameReader::isValid, "frameNumber"_a,
+             "True while the frame has not been overwritten by the publisher.")
+        .def_prop_ro("framesPublished", &SharedFrameReader::framesPublished)
+        .def_prop_ro("publisherClosed", &SharedFrameReader::publisherClosed)
+        .def_prop_ro("dropped", &SharedFrameReader::dropped)
+        .def_prop_ro("slotCount", &SharedFrameReader::slotCount)
+        .def_prop_ro("name", &SharedFrameReader::name);
+
+    nb::class_<FrameCompressor>(m, "FrameCompressor", R"doc(
+Losslessly compresses acquired frames on a pool of worker threads.
+
+
+Once started, frames are popped from the circular buffer (so nothing else
+should pop images), byte-shuffled and LZ4-compressed in parallel, and returned
+by `next()` in acquisition order as self-describing chunks ready to be
+written.  For 16-bit pixels, the bit depth reported by `getImageBitDepth()`
+when `start()` is called is used to pack the unused high bits (e.g. 12-bit
+data).  `decompress()` restores a chunk to the array `popNextImage()` would
+have returned; the payload after the 44-byte header is a standard LZ4 block (or the raw
+data if it did not compress).
+)doc")
+        .def(nb::init<CMMCore &, unsigned, bool, size_t>(), "core"_a, "threads"_a = 0,
+             "shuffle"_a = true, "maxPending"_a = 64, nb::keep_alive<1, 2>())
+        .def("start", &FrameCompressor::start,
+             "Starts popping and compressing frames from the circular buffer." RGIL("FrameCompressor.start"))
+        .def("stop", &FrameCompressor::stop,
+             "Stops popping frames; frames already popped are still compressed." RGIL("FrameCompressor.stop"))
+        .def("isRunning", &FrameCompressor::isRunning,
+             "False if stopped, or if compression failed (see `lastError`).")
+        .def_prop_ro("lastError", &FrameCompressor::lastError,
+                     "Error that stopped compression, or an empty string.")
+        .def_prop_ro("threads", &FrameCompressor::threads)
+        .def_prop_ro("bytesIn", &FrameCompressor::bytesIn, "Uncompressed bytes popped so far.")
+        .def_prop_ro("bytesOut", &FrameCompressor::bytesOut, "Compressed bytes produced so far.")
+        .def(
+            "next",
+            [](FrameCompressor &self, double timeout_ms) -> nb::object {
+                std::optional<FrameCompressor::Chunk> chunk;
+                {
+                    nb::gil_scoped_release release;
+                    chunk = self.next(timeout_ms);
+                }
+                if (!chunk)
+                    return nb::none();
+                return nb::make_tuple(
+                    nb::bytes(reinterpret_cast<const char *>(chunk->data.data()),
+                              chunk->data.size()),
+                    chunk->number);
+            },
+            "timeout_ms"_a = -1.0,
+            nb::sig("def next(self, timeout_ms: float = -1.0) -> tuple[bytes, int] | None"),
+            R"doc(Waits for the next compressed frame, returned as `(chunk, frameNumber)`.
+
+
+Returns None on timeout (a negative timeout waits indefinitely), or once
+stopped and all popped frames were returned.
+)doc")
+        .def_static(
+            "compress",
+            [](const nb::ndarray<nb::ro, nb::ndim<2>, nb::c_contig, nb::device::cpu> &image,
+               unsigned bitDepth, bool shuffle) {
+                nb::dlpack::dtype dt = image.dtype();
+                if (dt.code != static_cast<uint8_t>(nb::dlpack::dtype_code::UInt) ||
+                    (dt.bits != 8 && dt.bits != 16 && dt.bits != 32) || dt.lanes != 1)
+                    throw std::invalid_argument("image must be a uint8, uint16 or uint32 array");
+                ImageGeometry g{static_cast<unsigned>(image.shape(1)),
+                                static_cast<unsigned>(image.shape(0)), dt.bits / 8u, 1};
+                std::vector<uint8_t> chunk;
+                {
+                    nb::gil_scoped_release release;
+                    chunk = compress_frame(static_cast<const uint8_t *>(image.data()), g,
+                                           bitDepth, shuffle);
+                }
+                return nb::bytes(reinterpret_cast<const char *>(chunk.data()), chunk.size());
+            },
+            "image"_a, "bitDepth"_a = 0, "shuffle"_a = true,
+            "Compresses a 2D grayscale image into a chunk (`bitDepth` 0 = full pixel width).")
+        .def_static(
+            "decompress",
+            [](nb::bytes chunk) {
+                FrameChunkHeader header;
+                std::vector<uint8_t> pixels;
+                {
+                    nb::gil_scoped_release release;
+                    pixels = decompress_frame(reinterpret_cast<const uint8_t *>(chunk.c_str()),
+                                              chunk.size(), header);
+                }
+                return decompressed_frame_array(std::move(pixels), header);
+            },
+            "chunk"_a, "Restores the image stored in a compressed chunk.");
+
+    nb::class_<CircularBufferMonitor>(m, "CircularBufferMonitor", R"doc(
+Samples the circular buffer fill level from a background thread.
+
+
+Keeps the high-water mark, mean occupancy and the number of overflows seen,
+so that `autoSizeCircularBuffer` can be tuned to the actual acquisition.  The
+monitor never removes frames from the buffer.
+)doc")
+        .def(nb::init<CMMCore &>(), "core"_a, nb::keep_alive<1, 2>())
+        .def("start", &CircularBufferMonitor::start, "intervalMs"_a = 1.0,
+             "Starts sampling every `intervalMs` milliseconds (restarting if already running)." RGIL("CircularBufferMonitor.start"))
+        .def("stop", &CircularBufferMonitor::stop, "Stops sampling; statistics are kept." RGIL("CircularBufferMonitor.stop"))
+        .def("isRunning", &CircularBufferMonitor::isRunning)
+        .def("resetStatistics", &CircularBufferMonitor::resetStatistics,
+             "Resets all statistics to zero.")
+        .def(
+            "getStatistics",
+            [](const CircularBufferMonitor &self) {
+                CircularBufferMonitor::Statistics s = self.statistics();
+                nb::dict stats;
+                stats["capacity"] = s.capacity;
+                stats["occupancy"] = s.occupancy;
+                stats["highWaterMark"] = s.highWaterMark;
+                stats["meanOccupancy"] = s.meanOccupancy;
+                stats["overflows"] = s.overflows;
+                stats["samples"] = s.samples;
+                return stats;
+            },
+            R"doc(Returns the buffer statistics as a dict.
+
+
+`capacity` and `occupancy` (in frames) are from the latest sample;
+`highWaterMark` and `meanOccupancy` are the maximum and mean occupancy over
+all samples since the last reset.
+)doc");
+}
+
+///////////////// Platform memory query ///////////////////
+
+// Kept last so that the macros of <windows.h> cannot leak into the bindings.
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+uint64_t available_memory_bytes() {
+#ifdef _WIN32
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    return GlobalMemoryStatusEx(&status) ? status.ullAvailPhys : 0;
+#elif defined(_SC_AVPHYS_PAGES)
+    return uint64_t(sysconf(_SC_AVPHYS_PAGES)) * uint64_t(sysconf(_SC_PAGESIZE));
+#else
+    return uint64_t(sysconf(_SC_PHYS_PAGES)) * uint64_t(sysconf(_SC_PAGESIZE));
+#endif
 }
@@ -1,6 +1,8 @@
 """Tests focused on AutoFocus Device functionality to increase MMCore.cpp coverage."""
 
+import numpy as np
 import pymmcore_nano as pmn
+import pytest
 
 AF_DEVICE = "Autofocus"
 STAGE_DEVICE = "Z"
@@ -60,3 +62,39 @@ def test_autofocus_device_properties(demo_core: pmn.CMMCore) -> None:
 
         if not is_readonly:
             demo_core.setProperty(AF_DEVICE, prop_name, prop_value)
+
+
+def test_focus_score() -> None:
+    img = np.zeros((4, 6), dtype=np.uint16)
+    img[:, ::2] = 10  # a pattern with period two has no Brenner response
+    assert pmn.focusScore(img) == 0
+    img[:, 0] = 4
+    # only the first column differs from its neighbour two columns away
+    assert pmn.focusScore(img, "brenner") == pytest.approx(4 * 36 / 16)
+
+    rng = np.random.default_rng(0)
+    sharp = rng.integers(0, 255, size=(64, 64), dtype=np.uint8)
+    kernel = np.ones(5) / 5
+    blurred = np.apply_along_axis(np.convolve, 1, sharp, kernel, "same")
+    blurred = np.apply_along_axis(np.convolve, 0, blurred, kernel, "same")
+    blurred = np.ascontiguousarray(blurred.astype(np.uint8))
+    for metric in ("brenner", "laplacian", "variance"):
+        assert pmn.focusScore(sharp, metric) > pmn.focusScore(blurred, metric)
+
+    with pytest.raises(ValueError, match="metric"):
+        pmn.focusScore(sharp, "tenengrad")
+
+
+def test_software_autofocus(demo_core: pmn.CMMCore) -> None:
+    demo_core.setExposure(1)
+    positions = [0.0, 5.0, 10.0, 15.0]
+    result = demo_core.softwareAutofocus(positions, metric="laplacian")
+    np.testing.assert_array_equal(result["positions"], positions)
+    assert result["scores"].shape == (4,)
+    assert 0 <= result["bestPosition"] <= 15
+    assert demo_core.getPosition() == pytest.approx(result["bestPosition"])
+    assert not demo_core.isSequenceRunning()
+    assert result["sequenced"] is False
+
+    with pytest.raises(ValueError):
+        demo_core.softwareAutofocus([])
@@ -1,6 +1,8 @@
 from __future__ import annotations
 
+import gc
 import threading
+import weakref
 from collections import defaultdict
 from contextlib import contextmanager
 from typing import TYPE_CHECKING, Any
@@ -115,3 +117,55 @@ def test_callback(core: pmn.CMMCore, demo_config: Path):
 
     with assert_called("onShutterOpenChanged", core.getShutterDevice(), True):
         core.setShutterOpen(True)
+
+
+def test_subscribe_property(demo_core: pmn.CMMCore) -> None:
+    """Test that property subscriptions only fire for matching changes."""
+    exact: list[tuple[str, str, str]] = []
+    wildcard: list[tuple[str, str, str]] = []
+    unrelated: list[tuple[str, str, str]] = []
+
+    sub_id = demo_core.subscribeProperty(
+        "Camera", "Binning", lambda *args: exact.append(args)
+    )
+    wild_id = demo_core.subscribeProperty(
+        "*", "Binning", lambda *args: wildcard.append(args)
+    )
+    other_id = demo_core.subscribeProperty(
+        "Z", "*", lambda *args: unrelated.append(args)
+    )
+
+    demo_core.setProperty("Camera", "Binning", "2")
+    assert exact == [("Camera", "Binning", "2")]
+    assert wildcard == [("Camera", "Binning", "2")]
+    assert not unrelated
+
+    assert demo_core.unsubscribeProperty(sub_id)
+    assert not demo_core.unsubscribeProperty(sub_id)
+    demo_core.setProperty("Camera", "Binning", "1")
+    assert len(exact) == 1
+    assert wildcard[-1] == ("Camera", "Binning", "1")
+
+    assert demo_core.unsubscribeProperty(wild_id)
+    assert demo_core.unsubscribeProperty(other_id)
+
+
+def test_subscribed_core_is_collected() -> None:
+    """A core referenced only from its own subscription callback is collected."""
+
+    class Listener:
+        def __init__(self, core: pmn.CMMCore) -> None:
+            self.core = core
+            self.sub_id = core.subscribeProperty("*", "*", self.on_change)
+
+        def on_change(self, *args: str) -> None:
+            pass
+
+    core = pmn.CMMCore()
+    listener = Listener(core)
+    listener_ref = weakref.ref(listener)
+    core_ref = weakref.ref(core)
+    del core, listener
+    gc.collect()
+    assert core_ref() is None
+    assert listener_ref() is None
@@ -1,9 +1,11 @@
 from __future__ import annotations
 
+import time
 from typing import TYPE_CHECKING
 
 import numpy as np
 import numpy.testing as npt
+import pytest
 
 if TYPE_CHECKING:
     import pymmcore_nano as pmn
@@ -74,3 +76,193 @@ def test_image_ramps(demo_core: pmn.CMMCore):
     img = demo_core.getImage()
     assert img.dtype == np.uint16
     assert img.shape == (height, width, 3)
+
+
+def test_image_frameworks(demo_core: pmn.CMMCore):
+    demo_core.snapImage()
+    img = demo_core.getImage()
+
+    same = demo_core.getImage(framework="numpy")
+    npt.assert_array_equal(same, img)
+
+    neutral = demo_core.getImage(framework="dlpack")
+    assert not isinstance(neutral, np.ndarray)
+    npt.assert_array_equal(np.from_dlpack(neutral), img)
+    npt.assert_array_equal(np.asarray(neutral), img)
+
+    ch0 = demo_core.getImage(0, framework="dlpack")
+    npt.assert_array_equal(np.asarray(ch0), img)
+
+    with pytest.raises(ValueError, match="framework"):
+        demo_core.getImage(framework="tensorflow")
+
+    demo_core.startSequenceAcquisition(2, 0, False)
+    while demo_core.isSequenceRunning():
+        time.sleep(0.01)
+    last, md = demo_core.getLastImageMD(framework="dlpack")
+    assert type(md).__name__ == "Metadata"
+    assert np.asarray(last).shape == img.shape
+    popped = demo_core.popNextImageMD(md, framework="dlpack")
+    assert np.asarray(popped).shape == img.shape
+    before_last, _ = demo_core.getNBeforeLastImageMD(0, framework="numpy")
+    assert isinstance(before_last, np.ndarray)
+
+    torch = pytest.importorskip("torch")
+    tensor = demo_core.getImage(framework="torch")
+    assert isinstance(tensor, torch.Tensor)
+    assert tuple(tensor.shape) == img.shape
+
+    # RGB frames are views with a negative channel stride, which torch rejects
+    demo_core.setProperty("Camera", "PixelType", "32bitRGB")
+    demo_core.snapImage()
+    rgb = demo_core.getImage()
+    tensor = demo_core.getImage(framework="torch")
+    assert tuple(tensor.shape) == rgb.shape
+    npt.assert_array_equal(tensor.numpy(), rgb)
+
+
+def test_acquire_accumulated(demo_core: pmn.CMMCore):
+    # the test pattern is identical in every frame
+    demo_core.setProperty("Camera", "Mode", "Color Test Pattern")
+    demo_core.setProperty("Camera", "PixelType", "16bit")
+    demo_core.setExposure(1)
+    demo_core.snapImage()
+    img = demo_core.getImage()
+
+    mean = demo_core.acquireAccumulated(4)
+    assert not demo_core.isSequenceRunning()
+    assert mean.dtype == np.float32
+    npt.assert_allclose(mean, img)
+
+    total = demo_core.acquireAccumulated(4, mode="sum")
+    assert total.dtype == np.uint32
+    npt.assert_array_equal(total, img.astype(np.uint32) * 4)
+
+    brightest = demo_core.acquireAccumulated(3, mode="max")
+    assert brightest.dtype == np.uint16
+    npt.assert_array_equal(brightest, img)
+    assert not demo_core.isSequenceRunning()
+
+    demo_core.setProperty("Camera", "PixelType", "32bitRGB")
+    rgb = demo_core.acquireAccumulated(2, mode="sum")
+    assert rgb.shape == (img.shape[0], img.shape[1], 3)
+
+    with pytest.raises(ValueError, match="mode"):
+        demo_core.acquireAccumulated(2, mode="median")
+    with pytest.raises(ValueError):
+        demo_core.acquireAccumulated(0)
+
+
+def test_frame_correction(demo_core: pmn.CMMCore):
+    demo_core.setProperty("Camera", "Mode", "Color Test Pattern")
+    demo_core.setProperty("Camera", "PixelType", "16bit")
+    demo_core.snapImage()
+    raw = demo_core.getImage()
+    camera = demo_core.getCameraDevice()
+
+    dark = np.full(raw.shape, 100, dtype=np.float32)
+    flat = np.full(raw.shape, 1100, dtype=np.float32)
+    flat[:, : raw.shape[1] // 2] = 600  # left half is half as bright
+    demo_core.setFrameCorrection(camera, dark=dark, flat=flat, hotPixels=[(5, 7)])
+    assert demo_core.getFrameCorrectionCameras() == [camera]
+
+    corrected = demo_core.getImage()
+    assert corrected.dtype == np.float32
+    gain = (flat - dark).mean() / (flat - dark)
+    expected = (raw.astype(np.float32) - dark) * gain
+    expected[5, 7] = (
+        expected[5, 6] + expected[5, 8] + expected[4, 7] + expected[6, 7]
+    ) / 4
+    npt.assert_allclose(corrected, expected, rtol=1e-5)
+
+    demo_core.setFrameCorrection(camera, dark=dark, dtype="native")
+    native = demo_core.getImage()
+    assert native.dtype == np.uint16
+    npt.assert_array_equal(native, np.clip(raw.astype(np.int64) - 100, 0, None))
+
+    demo_core.clearFrameCorrection()
+    assert demo_core.getFrameCorrectionCameras() == []
+    npt.assert_array_equal(demo_core.getImage(), raw)
+
+    with pytest.raises(ValueError):
+        demo_core.setFrameCorrection(camera)
+    with pytest.raises(ValueError):
+        demo_core.setFrameCorrection(camera, dark=dark, flat=flat[:-1])
+    demo_core.setFrameCorrection(camera, dark=dark[:-1])
+    with pytest.raises(RuntimeError, match="image is"):
+        demo_core.getImage()
+
+    # RGB frames are corrected per color channel with the same maps
+    demo_core.clearFrameCorrection()
+    demo_core.setProperty("Camera", "PixelType", "32bitRGB")
+    demo_core.snapImage()
+    rgb = demo_core.getImage()
+    demo_core.setFrameCorrection(camera, dark=dark, flat=flat, hotPixels=[(5, 7)])
+    corrected = demo_core.getImage()
+    assert corrected.shape == rgb.shape
+    assert corrected.dtype == np.float32
+    expected = (rgb.astype(np.float32) - dark[..., None]) * gain[..., None]
+    expected[5, 7] = (
+        expected[5, 6] + expected[5, 8] + expected[4, 7] + expected[6, 7]
+    ) / 4
+    npt.assert_allclose(corrected, expected, rtol=1e-5)
+    demo_core.setFrameCorrection(camera, dark=dark, dtype="native")
+    native = demo_core.getImage()
+    assert native.dtype == np.uint8
+    npt.assert_array_equal(native, np.clip(rgb.astype(np.int64) - 100, 0, None))
+
+
+def test_software_roi(demo_core: pmn.CMMCore):
+    demo_core.setProperty("Camera", "Mode", "Color Test Pattern")
+    demo_core.setProperty("Camera", "PixelType", "16bit")
+    demo_core.snapImage()
+    raw = demo_core.getImage()
+    camera = demo_core.getCameraDevice()
+
+    # without a software ROI the list holds the whole frame
+    (whole,) = demo_core.getImageROIs()
+    npt.assert_array_equal(whole, raw)
+
+    demo_core.setSoftwareROI(camera, [(10, 20, 30, 40)])
+    assert demo_core.getSoftwareROI(camera) == [(10, 20, 30, 40)]
+    (crop,) = demo_core.getImageROIs()
+    npt.assert_array_equal(crop, raw[20:60, 10:40])
+    # the plain getters still return the full frame
+    npt.assert_array_equal(demo_core.getImage(), raw)
+
+    demo_core.setSoftwareROI(camera, [(0, 0, 8, 4), (10, 20, 4, 6)])
+    parts = demo_core.getImageROIs()
+    assert [p.shape for p in parts] == [(4, 8), (6, 4)]
+    npt.assert_array_equal(parts[0], raw[:4, :8])
+    npt.assert_array_equal(parts[1], raw[20:26, 10:14])
+
+    # corrections use full-frame maps and are applied to the crops only
+    dark = np.full(raw.shape, 100, dtype=np.float32)
+    demo_core.setFrameCorrection(camera, dark=dark)
+    corrected = demo_core.getImageROIs()
+    assert corrected[1].dtype == np.float32
+    npt.assert_allclose(corrected[1], raw[20:26, 10:14] - 100.0)
+    demo_core.clearFrameCorrection()
+
+    demo_core.setProperty("Camera", "PixelType", "32bitRGB")
+    demo_core.snapImage()
+    full = demo_core.getImage()
+    parts = demo_core.getImageROIs()
+    assert [p.shape for p in parts] == [(4, 8, 3), (6, 4, 3)]
+    npt.assert_array_equal(parts[0], full[:4, :8])
+    npt.assert_array_equal(parts[1], full[20:26, 10:14])
+
+    demo_core.startSequenceAcquisition(2, 0, False)
+    while demo_core.isSequenceRunning():
+        time.sleep(0.01)
+    parts, md = demo_core.popNextImageROIsMD()
+    assert type(md).__name__ == "Metadata"
+    assert [p.shape for p in parts] == [(4, 8, 3), (6, 4, 3)]
+    assert len(demo_core.popNextImageROIs()) == 2
+
+    demo_core.clearSoftwareROI()
+    assert demo_core.getSoftwareROI(camera) == []
+
+    demo_core.setSoftwareROI(camera, [(0, 0, 100000, 4)])
+    with pytest.raises(RuntimeError, match="exceeds"):
+        demo_core.getImageROIs()
@@ -0,0 +1,126 @@
+from __future__ import annotations
+
+import struct
+
+import numpy as np
+import numpy.testing as npt
+import pymmcore_nano as pmn
+import pytest
+
+
+@pytest.mark.parametrize("dtype", [np.uint8, np.uint16, np.uint32])
+def test_compress_roundtrip(dtype: type) -> None:
+    rng = np.random.default_rng(0)
+    img = rng.integers(0, np.iinfo(dtype).max, size=(64, 80), dtype=dtype)
+    chunk = pmn.FrameCompressor.compress(img)
+    assert isinstance(chunk, bytes)
+    npt.assert_array_equal(pmn.FrameCompressor.decompress(chunk), img)
+
+
+def test_compress_bit_depth() -> None:
+    y, x = np.mgrid[0:256, 0:256]
+    img = ((x * 16 + y) % 4096).astype(np.uint16)  # 12-bit data
+    full = pmn.FrameCompressor.compress(img)
+    packed = pmn.FrameCompressor.compress(img, bitDepth=12)
+    plain = pmn.FrameCompressor.compress(img, shuffle=False)
+    assert len(packed) < len(full) < img.nbytes
+    assert len(packed) < len(plain)
+    npt.assert_array_equal(pmn.FrameCompressor.decompress(packed), img)
+
+    # pixels above the declared bit depth are still stored losslessly
+    img[0, 0] = 65535
+    lying = pmn.FrameCompressor.compress(img, bitDepth=12)
+    npt.assert_array_equal(pmn.FrameCompressor.decompress(lying), img)
+
+
+def test_decompress_rejects_garbage() -> None:
+    with pytest.raises(ValueError):
+        pmn.FrameCompressor.decompress(b"not a chunk")
+    chunk = pmn.FrameCompressor.compress(np.zeros((32, 32), np.uint16))
+    with pytest.raises(ValueError):
+        pmn.FrameCompressor.decompress(chunk[:-1])
+
+
+# Layout of the FrameChunkHeader at the start of every chunk.
+HEADER = struct.Struct("<4sBBBB5IQQ")
+HEADER_FIELDS = (
+    "magic version codec shuffled highBits width height bytesPerPixel "
+    "numComponents bitDepth rawSize payloadSize"
+).split()
+
+
+def _with_header(chunk: bytes, **changes: int) -> bytes:
+    fields = list(HEADER.unpack_from(chunk))
+    for name, value in changes.items():
+        fields[HEADER_FIELDS.index(name)] = value
+    return HEADER.pack(*fields) + chunk[HEADER.size :]
+
+
+@pytest.mark.parametrize(
+    "changes",
+    [
+        {"shuffled": 0},  # packed high bits without byte planes
+        {"highBits": 8},
+        {"bytesPerPixel": 3},
+        {"bytesPerPixel": 1, "numComponents": 4},
+        {"numComponents": 3},
+        {"width": 0xFFFFFFFF, "height": 0xFFFFFFFF},
+        {"width": 16},  # rawSize no longer matches
+        {"rawSize": 1 << 40},
+        {"codec": 7},
+    ],
+)
+def test_decompress_rejects_malformed_header(changes: dict[str, int]) -> None:
+    y, x = np.mgrid[0:32, 0:32]
+    img = ((x * 16 + y) % 4096).astype(np.uint16)
+    chunk = pmn.FrameCompressor.compress(img, bitDepth=12)
+    assert HEADER.unpack_from(chunk)[HEADER_FIELDS.index("highBits")] == 4
+    with pytest.raises(ValueError):
+        pmn.FrameCompressor.decompress(_with_header(chunk, **changes))
+
+
+def test_decompress_rejects_oversized_lz4_claim() -> None:
+    chunk = pmn.FrameCompressor.compress(np.zeros((64, 64), np.uint8), shuffle=False)
+    assert HEADER.unpack_from(chunk)[HEADER_FIELDS.index("codec")] == 1
+    huge = _with_header(chunk, width=1 << 16, height=1 << 16, rawSize=1 << 32)
+    with pytest.raises(ValueError):
+        pmn.FrameCompressor.decompress(huge)
+
+
+def test_decompress_rejects_corrupt_lz4_payload() -> None:
+    chunk = pmn.FrameCompressor.compress(np.zeros((64, 64), np.uint8), shuffle=False)
+    corrupt = chunk[: HEADER.size] + b"\xff" * (len(chunk) - HEADER.size)
+    with pytest.raises(ValueError, match="LZ4"):
+        pmn.FrameCompressor.decompress(corrupt)
+
+
+def test_payload_is_a_standard_lz4_block() -> None:
+    lz4_block = pytest.importorskip("lz4.block")
+    img = np.tile(np.arange(64, dtype=np.uint8), (64, 1))
+    chunk = pmn.FrameCompressor.compress(img, shuffle=False)
+    fields = dict(zip(HEADER_FIELDS, HEADER.unpack_from(chunk)))
+    assert fields["codec"] == 1
+    raw = lz4_block.decompress(chunk[HEADER.size :], uncompressed_size=fields["rawSize"])
+    assert raw == img.tobytes()
+
+
+def test_compressor_pipeline(demo_core: pmn.CMMCore) -> None:
+    demo_core.setExposure(1)
+    compressor = pmn.FrameCompressor(demo_core, threads=3, maxPending=4)
+    assert compressor.threads == 3
+    compressor.start()
+    assert compressor.isRunning()
+    demo_core.startSequenceAcquisition(10, 0, False)
+
+    shape = (demo_core.getImageHeight(), demo_core.getImageWidth())
+    for expected in range(10):
+        result = compressor.next(timeout_ms=5000)
+        assert result is not None, compressor.lastError
+        chunk, number = result
+        assert number == expected
+        img = pmn.FrameCompressor.decompress(chunk)
+        assert img.shape == shape
+    compressor.stop()
+    assert compressor.lastError == ""
+    assert compressor.next(timeout_ms=0) is None
+    assert 0 < compressor.bytesOut < compressor.bytesIn
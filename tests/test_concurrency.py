@@ -0,0 +1,256 @@
+import sys
+import sysconfig
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+import pymmcore_nano as pmn
+import pytest
+
+N_ITER = 50
+
+
+def test_concurrency_groups(demo_core: pmn.CMMCore) -> None:
+    groups = demo_core.getDeviceConcurrencyGroups()
+    flat = [label for group in groups for label in group]
+    assert sorted(flat) == sorted(d for d in demo_core.getLoadedDevices() if d != "Core")
+    for group in groups:
+        assert len({demo_core.getDeviceLibrary(label) for label in group}) == 1
+    assert ["LED Shutter"] in groups
+
+
+def _load_foreign_stage(core: pmn.CMMCore) -> str:
+    """Load a stage from an adapter module other than DemoCamera, if any works."""
+    for library in core.getDeviceAdapterNames():
+        if library in ("DemoCamera", "Utilities"):
+            continue
+        try:
+            names = core.getAvailableDevices(library)
+            types = core.getAvailableDeviceTypes(library)
+        except pmn.CMMError:
+            continue
+        for name, dev_type in zip(names, types):
+            if dev_type != pmn.DeviceType.StageDevice:
+                continue
+            try:
+                core.loadDevice("ForeignZ", library, name)
+                core.initializeDevice("ForeignZ")
+                return "ForeignZ"
+            except pmn.CMMError:
+                if "ForeignZ" in core.getLoadedDevices():
+                    core.unloadDevice("ForeignZ")
+    return ""
+
+
+def test_disjoint_devices_under_contention(demo_core: pmn.CMMCore) -> None:
+    """Drive several devices from separate threads and check every result."""
+    demo_core.setExposure(1)
+    n_states = demo_core.getNumberOfStates("Dichroic")
+    width = demo_core.getImageWidth()
+    height = demo_core.getImageHeight()
+
+    def move_xy() -> None:
+        for i in range(N_ITER):
+            demo_core.setXYPosition("XY", i * 10.0, -i * 5.0)
+            x, y = demo_core.getXYPosition("XY")
+            assert x == pytest.approx(i * 10.0, abs=0.1)
+            assert y == pytest.approx(-i * 5.0, abs=0.1)
+
+    def move_z() -> None:
+        for i in range(N_ITER):
+            demo_core.setPosition("Z", float(i))
+            assert demo_core.getPosition("Z") == pytest.approx(i, abs=0.1)
+
+    def switch_state() -> None:
+        for i in range(N_ITER):
+            demo_core.setState("Dichroic", i % n_states)
+            assert demo_core.getState("Dichroic") == i % n_states
+
+    def snap() -> None:
+        for _ in range(N_ITER):
+            demo_core.snapImage()
+            assert demo_core.getImage().shape == (height, width)
+
+    # "LED Shutter" belongs to the Utilities module, so it takes a different
+    # module lock than the DemoCamera devices above.
+    assert demo_core.getDeviceLibrary("LED Shutter") != "DemoCamera"
+
+    def toggle_shutter() -> None:
+        for i in range(N_ITER):
+            demo_core.setShutterOpen("LED Shutter", i % 2 == 0)
+            assert demo_core.getShutterOpen("LED Shutter") == (i % 2 == 0)
+
+    workers = [move_xy, move_z, switch_state, snap, toggle_shutter]
+
+    foreign_stage = _load_foreign_stage(demo_core)
+    if foreign_stage:
+
+        def move_foreign_stage() -> None:
+            for i in range(N_ITER):
+                demo_core.setPosition(foreign_stage, float(i))
+                assert demo_core.getPosition(foreign_stage) == pytest.approx(i, abs=0.1)
+
+        workers.append(move_foreign_stage)
+
+    with ThreadPoolExecutor(max_workers=len(workers)) as pool:
+        futures = [pool.submit(fn) for fn in workers]
+        for future in futures:
+            future.result(timeout=60)  # re-raises assertion errors from workers
+
+
+@pytest.mark.skipif(bool(pmn._HOLD_GIL), reason="built with HOLD_GIL")
+def test_device_calls_release_gil(demo_core: pmn.CMMCore) -> None:
+    """Python threads keep running while a device call blocks in C++."""
+    demo_core.setExposure(300)
+    ticks = 0
+    done = threading.Event()
+
+    def count() -> None:
+        nonlocal ticks
+        while not done.is_set():
+            ticks += 1
+            time.sleep(0.001)
+
+    counter = threading.Thread(target=count)
+    counter.start()
+    try:
+        demo_core.snapImage()
+    finally:
+        done.set()
+        counter.join()
+    assert ticks > 10
+
+
+@pytest.mark.skipif(
+    not sysconfig.get_config_var("Py_GIL_DISABLED"), reason="requires free-threaded Python"
+)
+def test_free_threaded_gil_stays_disabled() -> None:
+    # importing an extension that does not declare free-threading support
+    # would have re-enabled the GIL
+    assert not sys._is_gil_enabled()
+
+
+def test_multithreaded_stress(demo_core: pmn.CMMCore) -> None:
+    """Hammer shared binding state from many threads at once."""
+    demo_core.setExposure(1)
+    md = pmn.Metadata()
+    n_threads = 8
+    barrier = threading.Barrier(n_threads)
+
+    def work(idx: int) -> None:
+        barrier.wait()
+        for i in range(N_ITER):
+            key = f"key-{idx}-{i}"
+            md[key] = str(i)
+            assert md[key] == str(i)
+            assert md.HasTag(key)
+            md.GetKeys()
+            demo_core.log(f"stress-{idx}-{i}", pmn.LogLevel.LogLevelDebug, f"t{idx}")
+            demo_core.setLoggerLevel(f"t{idx}", pmn.LogLevel.LogLevelInfo)
+            demo_core.getProperty("Camera", "Binning")
+            demo_core.getSystemStateCache()
+            if idx == 0 and i % 10 == 0:
+                demo_core.snapImage()
+                demo_core.getImage()
+            del md[key]
+
+    with ThreadPoolExecutor(max_workers=n_threads) as pool:
+        futures = [pool.submit(work, i) for i in range(n_threads)]
+        for future in futures:
+            future.result(timeout=120)
+    assert md.GetKeys() == []
+    assert len(demo_core.getLoggerLevels()) == n_threads
+
+
+def test_shared_metadata_object(demo_core: pmn.CMMCore) -> None:
+    """Image getters fill a Metadata object that other threads use meanwhile."""
+    demo_core.startSequenceAcquisition(10, 0, True)
+    while demo_core.isSequenceRunning():
+        time.sleep(0.01)
+    md = pmn.Metadata()
+    n_threads = 4
+    barrier = threading.Barrier(n_threads)
+
+    def work(idx: int) -> None:
+        barrier.wait()
+        for i in range(N_ITER):
+            if idx == 0:
+                demo_core.getLastImageMD(md)
+                demo_core.getNBeforeLastImageMD(1, md)
+            else:
+                md[f"key-{idx}"] = str(i)
+                md.GetKeys()
+                md.HasTag("Camera")
+
+    with ThreadPoolExecutor(max_workers=n_threads) as pool:
+        futures = [pool.submit(work, i) for i in range(n_threads)]
+        for future in futures:
+            future.result(timeout=60)
+    assert md.HasTag("Camera")
+    demo_core.clearCircularBuffer()
+
+
+def test_concurrent_start_stop(demo_core: pmn.CMMCore) -> None:
+    """start() and stop() of the background workers may race from many threads."""
+    telemetry = pmn.StageTelemetry(demo_core, zStage="Z")
+    compressor = pmn.FrameCompressor(demo_core, threads=2)
+    monitor = pmn.CircularBufferMonitor(demo_core)
+    n_threads = 4
+    barrier = threading.Barrier(n_threads)
+
+    def toggle(idx: int) -> None:
+        barrier.wait()
+        for i in range(N_ITER // 5):
+            if (idx + i) % 2:
+                telemetry.start(1)
+                compressor.start()
+                monitor.start(1)
+            else:
+                telemetry.stop()
+                compressor.stop()
+                monitor.stop()
+
+    with ThreadPoolExecutor(max_workers=n_threads) as pool:
+        futures = [pool.submit(toggle, i) for i in range(n_threads)]
+        for future in futures:
+            future.result(timeout=60)
+    telemetry.stop()
+    compressor.stop()
+    monitor.stop()
+    assert not telemetry.isRunning()
+    assert not compressor.isRunning()
+    assert not monitor.isRunning()
+
+
+@pytest.mark.skipif(bool(pmn._HOLD_GIL), reason="built with HOLD_GIL")
+def test_gil_policy(demo_core: pmn.CMMCore) -> None:
+    policy = pmn.getGILPolicy()
+    assert policy["snapImage"] is True
+    assert policy["getTimeoutMs"] is False
+    assert policy["getPrimaryLogLevel"] is False
+    assert policy["setPrimaryLogLevel"] is True
+    assert policy["StageTelemetry.start"] is True
+    assert policy["softwareAutofocus"] is True
+    assert policy["focusScore"] is True
+    for method in (
+        "tileScan",
+        "serialTransact",
+        "readFromSerialPort",
+        "readSerialInto",
+        "registerSLMPattern",
+        "displaySLMPattern",
+        "fireGalvoPointSequence",
+    ):
+        assert policy[method] is True
+
+    try:
+        pmn.setGILPolicy("getExposure", False)
+        assert pmn.getGILPolicy()["getExposure"] is False
+        demo_core.setExposure(5)
+        assert demo_core.getExposure() == 5
+    finally:
+        pmn.resetGILPolicy()
+    assert pmn.getGILPolicy() == policy
+
+    with pytest.raises(ValueError, match="No GIL policy"):
+        pmn.setGILPolicy("notAMethod", True)
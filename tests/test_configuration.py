@@ -1,4 +1,7 @@
+from pathlib import Path
+
 import pymmcore_nano as pmn
+import pytest
 
 
 def test_system_configuration_management(demo_core: pmn.CMMCore) -> None:
@@ -158,3 +161,122 @@ def test_core_properties(demo_core: pmn.CMMCore) -> None:
 
             if prop_name != pmn.g_Keyword_CoreInitialize:
                 demo_core.setProperty(core_device, prop_name, prop_value)
+
+
+def test_validate_system_configuration(
+    core: pmn.CMMCore, demo_config: Path, tmp_path: Path
+) -> None:
+    """Test configuration file validation without loading devices."""
+    assert core.validateSystemConfiguration(demo_config) == []
+    assert core.getLoadedDevices() == ["Core"]
+
+    bad = tmp_path / "bad.cfg"
+    bad.write_text(
+        "# comment\n"
+        "Device,Camera,DemoCamera,DCam\n"
+        "Device,Camera,DemoCamera,DCam\n"
+        "Device,Foo,NotAnAdapter,Foo\n"
+        "Property,Stage,Position,1\n"
+        "FocusDirection,Camera,abc\n"
+        "Bogus,1,2\n"
+    )
+    issues = core.validateSystemConfiguration(bad)
+    assert any(i.startswith("line 3:") and "duplicate" in i for i in issues)
+    assert any(i.startswith("line 4:") and "NotAnAdapter" in i for i in issues)
+    assert any(i.startswith("line 5:") and "Stage" in i for i in issues)
+    assert any(i.startswith("line 6:") and "not a number" in i for i in issues)
+    assert any(i.startswith("line 7:") and "Bogus" in i for i in issues)
+
+
+def test_device_initialization_order(core: pmn.CMMCore, demo_config: Path) -> None:
+    """Test dependency-ordered and timed device initialization."""
+    core.loadSystemConfiguration(demo_config)
+    levels = core.getDeviceInitializationOrder()
+    flat = [label for level in levels for label in level]
+    assert sorted(flat) == sorted(d for d in core.getLoadedDevices() if d != "Core")
+    hub_level = next(i for i, lvl in enumerate(levels) if "DHub" in lvl)
+    cam_level = next(i for i, lvl in enumerate(levels) if "Camera" in lvl)
+    assert hub_level < cam_level
+
+    assert core.getCameraDevice() == "Camera"
+    assert core.isConfigDefined("Channel", "DAPI")
+
+    core.unloadAllDevices()
+    core.loadDevice("DHub", "DemoCamera", "DHub")
+    core.loadDevice("Camera", "DemoCamera", "DCam")
+    core.loadDevice("Z", "DemoCamera", "DStage")
+    core.setParentLabel("Camera", "DHub")
+    timings = dict(core.initializeAllDevicesTimed())
+    assert set(timings) == {"DHub", "Camera", "Z"}
+    assert all(t >= 0 for t in timings.values())
+    # default roles are assigned as by initializeAllDevices()
+    assert core.getCameraDevice() == "Camera"
+    assert core.getFocusDevice() == "Z"
+    assert core.initializeAllDevicesTimed() == []
+
+
+def test_initialize_all_devices_timed_after_config(
+    core: pmn.CMMCore, demo_config: Path, tmp_path: Path
+) -> None:
+    # a configuration that stops before Core,Initialize leaves the devices to us
+    text = demo_config.read_text()
+    cfg = tmp_path / "deferred.cfg"
+    cfg.write_text(text[: text.index("Property,Core,Initialize,1")])
+    core.loadSystemConfiguration(cfg)
+    timings = core.initializeAllDevicesTimed()
+    labels = [label for label, _ in timings]
+    assert set(labels) == {d for d in core.getLoadedDevices() if d != "Core"}
+    assert labels.index("DHub") < labels.index("Camera")
+
+
+def test_system_snapshot(demo_core: pmn.CMMCore, tmp_path: Path) -> None:
+    """Test binary snapshot and diff-based restore of the system state."""
+    snap = demo_core.getSystemSnapshot()
+    assert isinstance(snap, bytes)
+    assert demo_core.setSystemSnapshot(snap) == 0
+
+    demo_core.setExposure(42)
+    demo_core.setProperty("Camera", "Binning", "2")
+    demo_core.defineConfigGroup("NewGroup")
+    demo_core.deleteConfig("Channel", "DAPI")
+    demo_core.setPixelSizeUm("Res10x", 3.0)
+    assert demo_core.setSystemSnapshot(snap) >= 5
+
+    assert demo_core.getExposure() == 10
+    assert demo_core.getProperty("Camera", "Binning") == "1"
+    assert not demo_core.isGroupDefined("NewGroup")
+    assert demo_core.isConfigDefined("Channel", "DAPI")
+    assert demo_core.getPixelSizeUmByID("Res10x") == 1.0
+    assert demo_core.setSystemSnapshot(snap) == 0
+
+    path = tmp_path / "state.mmsnap"
+    demo_core.saveSystemSnapshot(path)
+    assert path.read_bytes() == snap
+    assert demo_core.loadSystemSnapshot(path) == 0
+
+    with pytest.raises(ValueError, match="Invalid system snapshot"):
+        demo_core.setSystemSnapshot(b"not a snapshot")
+
+
+def test_configuration_arrays(demo_core: pmn.CMMCore) -> None:
+    """Test columnar export and import of configurations."""
+    cfg = demo_core.getConfigData("Channel", "DAPI")
+    devices, props, values = cfg.to_arrays()
+    assert len(devices) == len(props) == len(values) == cfg.size()
+    for i in range(cfg.size()):
+        setting = cfg.getSetting(i)
+        assert devices[i] == setting.getDeviceLabel()
+        assert props[i] == setting.getPropertyName()
+        assert values[i] == setting.getPropertyValue()
+    assert demo_core.getConfigDataArrays("Channel", "DAPI") == (devices, props, values)
+
+    rebuilt = pmn.Configuration.from_arrays(devices, props, values)
+    assert rebuilt.isConfigurationIncluded(cfg)
+    assert cfg.isConfigurationIncluded(rebuilt)
+
+    px = demo_core.getPixelSizeConfigData("Res10x").to_arrays()
+    assert demo_core.getPixelSizeConfigDataArrays("Res10x") == px
+    assert px[0] == ["Objective"]
+
+    with pytest.raises(ValueError, match="same length"):
+        pmn.Configuration.from_arrays(["Camera"], [], ["1"])
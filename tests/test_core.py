@@ -372,6 +372,47 @@ def test_image_sequence(demo_core: pmn.CMMCore) -> None:
     demo_core.clearCircularBuffer()
 
 
+def test_auto_size_circular_buffer(demo_core: pmn.CMMCore) -> None:
+    frame_bytes = demo_core.getImageBufferSize()
+    demo_core.setExposure(10)  # 100 frames per second
+    size_mb = demo_core.autoSizeCircularBuffer(bufferSeconds=2.0)
+    assert size_mb == -(-frame_bytes * 200 // 2**20)
+    assert demo_core.getCircularBufferMemoryFootprint() == size_mb
+
+    assert demo_core.autoSizeCircularBuffer(1.0, frameRate=50) < size_mb
+    with pytest.raises(ValueError):
+        demo_core.autoSizeCircularBuffer(maxMemoryFraction=0)
+
+
+def test_circular_buffer_monitor(demo_core: pmn.CMMCore) -> None:
+    demo_core.setExposure(5)
+    demo_core.setCircularBufferMemoryFootprint(10)
+    capacity = demo_core.getBufferTotalCapacity()
+
+    n_frames = capacity // 2
+
+    monitor = pmn.CircularBufferMonitor(demo_core)
+    monitor.start(intervalMs=1)
+    assert monitor.isRunning()
+    demo_core.startSequenceAcquisition(n_frames, 0, True)
+    _wait_until(lambda: not demo_core.isSequenceRunning())
+    _wait_until(lambda: monitor.getStatistics()["highWaterMark"] == n_frames)
+    monitor.stop()
+
+    stats = monitor.getStatistics()
+    assert stats["capacity"] == capacity
+    assert stats["occupancy"] == n_frames
+    assert stats["overflows"] == 0
+    assert stats["samples"] > 0
+    assert 0 < stats["meanOccupancy"] <= n_frames
+    # the monitor only observes; every frame is still there for the consumer
+    assert demo_core.getRemainingImageCount() == n_frames
+
+    monitor.resetStatistics()
+    assert monitor.getStatistics()["samples"] == 0
+    demo_core.clearCircularBuffer()
+
+
 def test_image_sequence_errors(demo_core: pmn.CMMCore) -> None:
     md = pmn.Metadata()
     with pytest.raises(pmn.CMMError):
@@ -414,3 +455,23 @@ def test_feature():
     assert pmn.CMMCore.isFeatureEnabled(feature_name)
     pmn.CMMCore.enableFeature(feature_name, False)
     assert not pmn.CMMCore.isFeatureEnabled(feature_name)
+
+
+def test_tile_scan(demo_core: pmn.CMMCore) -> None:
+    positions = np.array([[0, 0, 1], [100, 0, 2], [100, 100, 3], [0, 100, 4]], float)
+    frames: list[tuple[int, np.ndarray, tuple]] = []
+    demo_core.tileScan(positions, lambda i, img, pos: frames.append((i, img, pos)))
+
+    assert [f[0] for f in frames] == [0, 1, 2, 3]
+    assert [f[2] for f in frames] == [tuple(p) for p in positions]
+    shape = (demo_core.getImageHeight(), demo_core.getImageWidth())
+    assert all(f[1].shape == shape for f in frames)
+    x, y = demo_core.getXYPosition()
+    assert (x, y) == pytest.approx((0, 100), abs=0.1)
+    assert demo_core.getPosition() == pytest.approx(4, abs=0.1)
+
+    demo_core.tileScan(positions[:, :2], lambda *args: frames.append(args))
+    assert len(frames) == 8 and len(frames[-1][2]) == 2
+
+    with pytest.raises(ValueError, match="shape"):
+        demo_core.tileScan(np.zeros((3, 4)), lambda *args: None)
@@ -0,0 +1,43 @@
+from __future__ import annotations
+
+import numpy as np
+import pymmcore_nano as pmn
+import pytest
+
+
+@pytest.fixture
+def galvo_core(core: pmn.CMMCore) -> pmn.CMMCore:
+    """Return a core with the first galvo device found in the test adapters loaded."""
+    for library in core.getDeviceAdapterNames():
+        try:
+            names = core.getAvailableDevices(library)
+            types = core.getAvailableDeviceTypes(library)
+        except pmn.CMMError:
+            continue
+        for name, dev_type in zip(names, types):
+            if dev_type == pmn.DeviceType.GalvoDevice:
+                core.loadDevice("Galvo", library, name)
+                core.initializeDevice("Galvo")
+                return core
+    pytest.skip("No galvo device available in the test adapters")
+
+
+def test_load_galvo_polygons_from_arrays(galvo_core: pmn.CMMCore) -> None:
+    square = [[0, 0], [1, 0], [1, 1], [0, 1]]
+    triangle = [[2, 2], [3, 2], [2, 3]]
+    vertices = np.array(square + triangle, dtype=float)
+    galvo_core.loadGalvoPolygonsFromArrays("Galvo", vertices, np.array([0, 4]))
+    galvo_core.loadGalvoPolygonsFromArrays("Galvo", vertices, np.array([0, 4, 7]))
+
+    with pytest.raises(ValueError, match="polygonOffsets"):
+        galvo_core.loadGalvoPolygonsFromArrays("Galvo", vertices, np.array([0, 9]))
+    with pytest.raises(ValueError, match="polygonOffsets"):
+        galvo_core.loadGalvoPolygonsFromArrays("Galvo", vertices, np.array([4, 0]))
+
+
+def test_fire_galvo_point_sequence(galvo_core: pmn.CMMCore) -> None:
+    points = np.column_stack([np.linspace(0, 1, 20), np.linspace(1, 0, 20)])
+    starts = galvo_core.fireGalvoPointSequence("Galvo", points, 10, interval_us=2000)
+    assert starts.shape == (20,)
+    assert np.all(starts >= np.arange(20) * 0.002 - 1e-6)
+    assert np.all(np.diff(starts) > 0)
@@ -240,3 +240,206 @@ def test_enable_debug_log_sets_level(core: pmn.CMMCore) -> None:
     assert not core.debugLogEnabled()
     # enableDebugLog(False) should set level to Info
     assert core.getPrimaryLogLevel() == pmn.LogLevel.LogLevelInfo
+
+
+# ── in-memory log sink ────────────────────────────────────────────────────────
+
+
+def _drain_until(
+    core: pmn.CMMCore, done: Callable[[dict[str, list]], bool], timeout: float = 2.0
+) -> dict[str, list]:
+    """Drain the log sink until `done(records)`, accumulating every record."""
+    records: dict[str, list] = {k: [] for k in ("time", "level", "thread", "logger", "message")}
+    dropped = 0
+
+    def _poll() -> bool:
+        nonlocal dropped
+        batch = core.drainLogRecords()
+        for key, values in records.items():
+            values.extend(batch[key])
+        dropped += batch["dropped"]
+        return done(records)
+
+    _wait_until(_poll, timeout)
+    records["dropped"] = dropped  # type: ignore[assignment]
+    return records
+
+
+def test_log_sink_records(core: pmn.CMMCore) -> None:
+    with pytest.raises(RuntimeError, match="not running"):
+        core.drainLogRecords()
+
+    core.startLogSink(capacity=1000)
+    try:
+        before = time.time()
+        core.log("sink-msg", pmn.LogLevel.LogLevelWarning, "sink-logger")
+        core.log(lambda: "lazy\nmulti-line", pmn.LogLevel.LogLevelInfo, "lazy")
+        core.logMessage("app-msg")
+        core.logMessage("debug-msg", True)  # debug messages are not captured by default
+        core.log("trace-msg", pmn.LogLevel.LogLevelTrace)
+        # messages logged by MMCore itself are captured too
+        core.loadDevice("Camera", "DemoCamera", "DCam")
+
+        records = _drain_until(
+            core,
+            lambda r: "app-msg" in r["message"]
+            and any(lg == "Core" and "DCam" in m for lg, m in zip(r["logger"], r["message"])),
+        )
+        ours = [
+            (message, logger, level)
+            for message, logger, level in zip(records["message"], records["logger"], records["level"])
+            if logger != "Core"
+        ]
+        assert ours == [
+            ("sink-msg", "sink-logger", int(pmn.LogLevel.LogLevelWarning)),
+            ("lazy\nmulti-line", "lazy", int(pmn.LogLevel.LogLevelInfo)),
+            ("app-msg", "App", int(pmn.LogLevel.LogLevelInfo)),
+        ]
+        # times are parsed from MMCore's local timestamps (microsecond resolution)
+        assert before - 1e-3 <= records["time"][0] <= records["time"][-1] <= time.time()
+        assert records["dropped"] == 0
+
+        batch = core.drainLogRecords()
+        assert batch["time"].dtype == "float64"
+        assert batch["level"].dtype == "int32"
+        assert batch["thread"].dtype == "uint64"
+
+        core.startLogSink(capacity=1000, enableDebug=True)
+        core.logMessage("debug-msg", True)
+        records = _drain_until(core, lambda r: "debug-msg" in r["message"])
+        index = records["message"].index("debug-msg")
+        assert records["level"][index] == int(pmn.LogLevel.LogLevelDebug)
+    finally:
+        core.stopLogSink()
+
+    with pytest.raises(RuntimeError):
+        core.drainLogRecords()
+
+
+def test_log_sink_overflow(core: pmn.CMMCore) -> None:
+    core.startLogSink(capacity=2)
+    try:
+        for i in range(10):
+            core.log(f"overflow-{i}", pmn.LogLevel.LogLevelInfo)
+        records = _drain_until(core, lambda r: "overflow-9" in r["message"])
+        assert records["message"][-2:] == ["overflow-8", "overflow-9"]
+        # whatever was not drained in time was dropped, and counted
+        assert len(records["message"]) + records["dropped"] == 10
+    finally:
+        core.stopLogSink()
+
+
+# ── per-logger levels ─────────────────────────────────────────────────────────
+
+
+def test_logger_levels(core: pmn.CMMCore, tmp_path: Path) -> None:
+    assert core.getLoggerLevel("dev") is None
+    core.setLoggerLevel("dev", pmn.LogLevel.LogLevelError)
+    assert core.getLoggerLevel("dev") == pmn.LogLevel.LogLevelError
+    assert core.getLoggerLevels() == {"dev": pmn.LogLevel.LogLevelError}
+
+    logfile = tmp_path / "test.log"
+    core.setPrimaryLogFile(logfile)
+    core.setPrimaryLogLevel(pmn.LogLevel.LogLevelTrace)
+    core.log("dev-filtered", pmn.LogLevel.LogLevelWarning, "dev")
+    core.log("other-kept", pmn.LogLevel.LogLevelWarning, "other")
+    core.log("dev-kept", pmn.LogLevel.LogLevelError, "dev")
+    _wait_until(lambda: "dev-kept" in logfile.read_text())
+    text = logfile.read_text()
+    assert "other-kept" in text
+    assert "dev-filtered" not in text
+
+    core.resetLoggerLevel("dev")
+    assert core.getLoggerLevel("dev") is None
+    core.setLoggerLevel("a", pmn.LogLevel.LogLevelInfo)
+    core.clearLoggerLevels()
+    assert core.getLoggerLevels() == {}
+
+
+def test_lazy_log_message(core: pmn.CMMCore, tmp_path: Path) -> None:
+    logfile = tmp_path / "test.log"
+    core.setPrimaryLogFile(logfile)
+    core.setPrimaryLogLevel(pmn.LogLevel.LogLevelInfo)
+    calls: list[str] = []
+
+    def _msg(text: str) -> Callable[[], str]:
+        def _format() -> str:
+            calls.append(text)
+            return text
+
+        return _format
+
+    core.log(_msg("lazy-debug"), pmn.LogLevel.LogLevelDebug, "lazy")
+    assert calls == []
+
+    # a threshold drops messages before they are formatted
+    core.setLoggerLevel("lazy", pmn.LogLevel.LogLevelWarning)
+    core.log(_msg("lazy-info"), pmn.LogLevel.LogLevelInfo, "lazy")
+    core.log(_msg("other-info"), pmn.LogLevel.LogLevelInfo, "other")
+    core.log(_msg("lazy-warning"), pmn.LogLevel.LogLevelWarning, "lazy")
+    assert calls == ["other-info", "lazy-warning"]
+
+    # but never lets through what MMCore's log outputs would drop
+    core.setLoggerLevel("lazy", pmn.LogLevel.LogLevelDebug)
+    assert core.getPrimaryLogLevel() == pmn.LogLevel.LogLevelInfo
+    assert not core.debugLogEnabled()
+    core.log(_msg("lazy-targeted"), pmn.LogLevel.LogLevelDebug, "lazy")
+    assert calls == ["other-info", "lazy-warning"]
+
+    _wait_until(lambda: "lazy-warning" in logfile.read_text())
+    text = logfile.read_text()
+    assert "[IFO,other] other-info" in text
+    assert "[WRN,lazy] lazy-warning" in text
+    assert "lazy-info" not in text
+
+    # a debug log output lets targeted debug messages through
+    debugfile = tmp_path / "debug.log"
+    handle = core.startSecondaryLogFile(debugfile, enableDebug=True)
+    try:
+        core.log(_msg("lazy-targeted"), pmn.LogLevel.LogLevelDebug, "lazy")
+        core.log(_msg("lazy-trace"), pmn.LogLevel.LogLevelTrace, "lazy")
+        assert calls == ["other-info", "lazy-warning", "lazy-targeted"]
+        _wait_until(lambda: debugfile.exists() and "lazy-targeted" in debugfile.read_text())
+        assert "[dbg,lazy] lazy-targeted" in debugfile.read_text()
+    finally:
+        core.stopSecondaryLogFile(handle)
+
+    core.clearLoggerLevels()
+    assert core.getLoggerLevels() == {}
+    assert core.getPrimaryLogLevel() == pmn.LogLevel.LogLevelInfo
+
+
+def test_lazy_log_message_secondary_log(core: pmn.CMMCore, tmp_path: Path) -> None:
+    core.setPrimaryLogLevel(pmn.LogLevel.LogLevelInfo)
+    calls: list[str] = []
+
+    def _format() -> str:
+        calls.append("secondary-debug")
+        return "secondary-debug"
+
+    logfile = tmp_path / "secondary.log"
+    handle = core.startSecondaryLogFile(logfile, enableDebug=True)
+    try:
+        core.log(_format, pmn.LogLevel.LogLevelDebug, "other")
+        assert calls == ["secondary-debug"]
+        _wait_until(lambda: logfile.exists() and "secondary-debug" in logfile.read_text())
+    finally:
+        core.stopSecondaryLogFile(handle)
+
+    core.log(_format, pmn.LogLevel.LogLevelDebug, "other")
+    assert calls == ["secondary-debug"]
+
+
+def test_logger_level_sink(core: pmn.CMMCore) -> None:
+    """A threshold decides which messages reach the sink even though it is at Info."""
+    core.startLogSink()
+    try:
+        core.setLoggerLevel("targeted", pmn.LogLevel.LogLevelWarning)
+        core.log("targeted-info", pmn.LogLevel.LogLevelInfo, "targeted")
+        core.log("targeted-warning", pmn.LogLevel.LogLevelWarning, "targeted")
+        core.log("untargeted-debug", pmn.LogLevel.LogLevelDebug, "other")
+        core.log("untargeted-info", pmn.LogLevel.LogLevelInfo, "other")
+        records = _drain_until(core, lambda r: "untargeted-info" in r["message"])
+        assert records["message"] == ["targeted-warning", "untargeted-info"]
+    finally:
+        core.stopLogSink()
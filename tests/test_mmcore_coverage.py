@@ -604,6 +604,18 @@ def test_serial_port_errors(demo_core: pmn.CMMCore) -> None:
         demo_core.writeToSerialPort("NoSuchPort", [])
     with pytest.raises(pmn.CMMError):
         demo_core.readFromSerialPort("NoSuchPort")
+    with pytest.raises(pmn.CMMError):
+        demo_core.readSerialInto("NoSuchPort", bytearray(8), 1, 10)
+    with pytest.raises(ValueError, match="minBytes"):
+        demo_core.readSerialInto("NoSuchPort", bytearray(8), 9, 10)
+    with pytest.raises(pmn.CMMError):
+        demo_core.readSerialUntil("NoSuchPort", b"\r", 10)
+    with pytest.raises(ValueError, match="terminator"):
+        demo_core.readSerialUntil("NoSuchPort", b"", 10)
+    with pytest.raises(pmn.CMMError):
+        demo_core.serialTransact("NoSuchPort", [b"A", b"B"], b"\r", 10)
+    with pytest.raises(ValueError, match="term"):
+        demo_core.serialTransact("NoSuchPort", [b"A"], b"", 10)
 
 
 # ── Property sequence on Core device (hits IsCoreDeviceLabel branches) ─────
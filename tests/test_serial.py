@@ -0,0 +1,57 @@
+from __future__ import annotations
+
+import pymmcore_nano as pmn
+import pytest
+
+PROBE = "loopback?\n"
+
+
+@pytest.fixture
+def loopback_core(core: pmn.CMMCore) -> pmn.CMMCore:
+    """Return a core with a serial port from the test adapters that echoes writes."""
+    for library in core.getDeviceAdapterNames():
+        try:
+            names = core.getAvailableDevices(library)
+            types = core.getAvailableDeviceTypes(library)
+        except pmn.CMMError:
+            continue
+        for name, dev_type in zip(names, types):
+            if dev_type != pmn.DeviceType.SerialDevice:
+                continue
+            try:
+                core.loadDevice("Port", library, name)
+                core.initializeDevice("Port")
+                core.writeToSerialPort("Port", list(PROBE))
+                echo = core.readSerialUntil("Port", b"\n", 200)
+            except pmn.CMMError:
+                echo = b""
+            if echo == PROBE.encode():
+                return core
+            if "Port" in core.getLoadedDevices():
+                core.unloadDevice("Port")
+    pytest.skip("No loopback serial port available in the test adapters")
+
+
+def test_read_from_serial_port_returns_buffered_bytes(loopback_core: pmn.CMMCore) -> None:
+    loopback_core.writeToSerialPort("Port", list("abc\ndef"))
+    assert loopback_core.readSerialUntil("Port", b"\n", 500) == b"abc\n"
+    # "def" was read past the terminator and must come first
+    data = b""
+    for _ in range(100):
+        data += loopback_core.readFromSerialPort("Port")
+        if len(data) >= 3:
+            break
+    assert data == b"def"
+
+
+def test_read_serial_into(loopback_core: pmn.CMMCore) -> None:
+    loopback_core.writeToSerialPort("Port", list("12345"))
+    buf = bytearray(8)
+    n = loopback_core.readSerialInto("Port", buf, 5, 500)
+    assert n == 5
+    assert bytes(buf[:n]) == b"12345"
+
+
+def test_serial_transact(loopback_core: pmn.CMMCore) -> None:
+    answers = loopback_core.serialTransact("Port", [b"A", b"BC", b""], b"\r\n", 500)
+    assert answers == [b"A", b"BC", b""]
@@ -0,0 +1,153 @@
+from __future__ import annotations
+
+import json
+import os
+import subprocess
+import sys
+import time
+
+import pymmcore_nano as pmn
+import pytest
+
+pytestmark = pytest.mark.skipif(
+    sys.platform == "win32", reason="requires POSIX shared memory"
+)
+
+
+def test_shared_frame_roundtrip(demo_core: pmn.CMMCore) -> None:
+    name = f"pmn-test-{os.getpid()}"
+    publisher = pmn.SharedFramePublisher(demo_core, name, slotCount=4)
+    assert publisher.name == f"/{name}"
+    assert publisher.slotBytes == demo_core.getImageBufferSize()
+
+    reader = pmn.SharedFrameReader(name)
+    assert reader.slotCount == 4
+    assert reader.next(timeout_ms=0) is None
+    assert reader.latest() is None
+
+    publisher.start()
+    assert publisher.isRunning()
+    demo_core.startSequenceAcquisition(3, 0, False)
+
+    numbers = []
+    for _ in range(3):
+        frame = reader.next(timeout_ms=5000)
+        assert frame is not None
+        img, number = frame
+        assert img.shape == (demo_core.getImageHeight(), demo_core.getImageWidth())
+        assert img.dtype.itemsize == demo_core.getBytesPerPixel()
+        assert not img.flags.writeable
+        assert reader.isValid(number)
+        numbers.append(number)
+    assert numbers == [0, 1, 2]
+    assert reader.dropped == 0
+
+    img, number = reader.latest()
+    assert number == 2
+    publisher.stop()
+    assert publisher.lastError == ""
+    assert publisher.framesPublished == 3
+
+    del publisher
+    # the reader's mapping (and views into it) outlive the publisher
+    assert reader.publisherClosed
+    assert reader.next(timeout_ms=-1) is None
+    assert img.sum() >= 0
+    with pytest.raises(RuntimeError):
+        pmn.SharedFrameReader(name)
+
+
+def test_shared_frame_reader_drops(demo_core: pmn.CMMCore) -> None:
+    name = f"pmn-test-drop-{os.getpid()}"
+    publisher = pmn.SharedFramePublisher(demo_core, name, slotCount=2)
+    reader = pmn.SharedFrameReader(name)
+    publisher.start()
+    demo_core.startSequenceAcquisition(6, 0, False)
+    deadline = time.perf_counter() + 5
+    while publisher.framesPublished < 6:
+        assert time.perf_counter() < deadline, publisher.lastError
+        time.sleep(0.01)
+    publisher.stop()
+
+    img, number = reader.next(timeout_ms=0)
+    assert number == 4
+    assert reader.dropped == 4
+    assert not reader.isValid(0)
+
+
+def test_shared_frame_name_in_use(demo_core: pmn.CMMCore) -> None:
+    name = f"pmn-test-busy-{os.getpid()}"
+    publisher = pmn.SharedFramePublisher(demo_core, name, slotCount=2)
+    reader = pmn.SharedFrameReader(name)
+    with pytest.raises(RuntimeError, match="still running"):
+        pmn.SharedFramePublisher(demo_core, name, slotCount=2)
+    assert reader.slotCount == 2  # the live segment was left alone
+
+    del publisher
+    replacement = pmn.SharedFramePublisher(demo_core, name, slotCount=3)
+    assert pmn.SharedFrameReader(name).slotCount == 3
+    del replacement
+
+
+CRASHING_PUBLISHER_SCRIPT = """
+import os, sys
+import pymmcore_nano as pmn
+
+publisher = pmn.SharedFramePublisher(pmn.CMMCore(), sys.argv[1], slotCount=2, slotBytes=64)
+os._exit(0)  # leave the segment behind, as a crash would
+"""
+
+
+def test_shared_frame_replaces_crashed_publisher(demo_core: pmn.CMMCore) -> None:
+    name = f"pmn-test-crash-{os.getpid()}"
+    subprocess.run(
+        [sys.executable, "-c", CRASHING_PUBLISHER_SCRIPT, name], check=True, timeout=30
+    )
+    assert pmn.SharedFrameReader(name).slotCount == 2  # the stale segment is still there
+    publisher = pmn.SharedFramePublisher(demo_core, name, slotCount=4)
+    assert pmn.SharedFrameReader(name).slotCount == 4
+    del publisher
+
+
+READER_SCRIPT = """
+import json, sys
+import pymmcore_nano as pmn
+
+reader = pmn.SharedFrameReader(sys.argv[1])
+print("ready", flush=True)
+frames = []
+for _ in range(int(sys.argv[2])):
+    img, number = reader.next(timeout_ms=10000)
+    frames.append([number, list(img.shape), int(img.sum())])
+print(json.dumps(frames), flush=True)
+"""
+
+
+def test_shared_frame_reader_in_other_process(demo_core: pmn.CMMCore) -> None:
+    name = f"pmn-test-proc-{os.getpid()}"
+    n_frames = 3
+    publisher = pmn.SharedFramePublisher(demo_core, name, slotCount=n_frames + 1)
+    local = pmn.SharedFrameReader(name)
+    child = subprocess.Popen(
+        [sys.executable, "-c", READER_SCRIPT, name, str(n_frames)],
+        stdout=subprocess.PIPE,
+        text=True,
+    )
+    try:
+        assert child.stdout is not None
+        assert child.stdout.readline().strip() == "ready"
+        publisher.start()
+        demo_core.startSequenceAcquisition(n_frames, 0, False)
+        out, _ = child.communicate(timeout=30)
+    finally:
+        if child.poll() is None:
+            child.kill()
+        publisher.stop()
+    assert child.returncode == 0
+    assert publisher.lastError == ""
+
+    expected = []
+    for _ in range(n_frames):
+        img, number = local.next(timeout_ms=0)
+        expected.append([number, list(img.shape), int(img.sum())])
+    assert json.loads(out) == expected
@@ -0,0 +1,95 @@
+from __future__ import annotations
+
+import numpy as np
+import pymmcore_nano as pmn
+import pytest
+
+
+@pytest.fixture
+def slm_core(core: pmn.CMMCore) -> pmn.CMMCore:
+    """Return a core with the first SLM device found in the test adapters loaded."""
+    for library in core.getDeviceAdapterNames():
+        try:
+            names = core.getAvailableDevices(library)
+            types = core.getAvailableDeviceTypes(library)
+        except pmn.CMMError:
+            continue
+        for name, dev_type in zip(names, types):
+            if dev_type == pmn.DeviceType.SLMDevice:
+                core.loadDevice("SLM", library, name)
+                core.initializeDevice("SLM")
+                core.setSLMDevice("SLM")
+                return core
+    pytest.skip("No SLM device available in the test adapters")
+
+
+def _shape(core: pmn.CMMCore) -> tuple[int, int]:
+    return core.getSLMHeight("SLM"), core.getSLMWidth("SLM")
+
+
+def test_set_slm_image_dtypes(slm_core: pmn.CMMCore) -> None:
+    h, w = _shape(slm_core)
+    rgb = slm_core.getSLMBytesPerPixel("SLM") == 4
+
+    slm_core.setSLMImage("SLM", np.zeros((h, w), np.uint8))
+    slm_core.setSLMImage("SLM", np.linspace(0, 1, h * w, dtype=np.float32).reshape(h, w))
+    slm_core.setSLMImage("SLM", np.eye(h, w, dtype=bool))
+    # non-contiguous input is read through its strides
+    slm_core.setSLMImage("SLM", np.zeros((w, h), np.uint8).T)
+    slm_core.setSLMImage("SLM", np.zeros((h, w * 2), np.uint8)[:, ::2])
+    # negative strides (flipped views)
+    slm_core.setSLMImage("SLM", np.arange(h * w, dtype=np.uint8).reshape(h, w)[::-1, ::-1])
+    if rgb:
+        slm_core.setSLMImage("SLM", np.zeros((h, w, 3), np.float64))
+        slm_core.setSLMImage("SLM", np.zeros((h, w, 3), np.uint8)[::-1, :, ::-1])
+    slm_core.displaySLMImage("SLM")
+
+    with pytest.raises(ValueError, match="dimensions are wrong"):
+        slm_core.setSLMImage("SLM", np.zeros((h + 1, w), np.uint8))
+    with pytest.raises(ValueError, match="type is wrong"):
+        slm_core.setSLMImage("SLM", np.zeros((h, w), np.int64))
+    if not rgb:
+        with pytest.raises(ValueError, match="support RGB"):
+            slm_core.setSLMImage("SLM", np.zeros((h, w, 3), np.uint8))
+
+
+def test_load_slm_sequence_stacked(slm_core: pmn.CMMCore) -> None:
+    h, w = _shape(slm_core)
+    try:
+        max_len = slm_core.getSLMSequenceMaxLength("SLM")
+    except pmn.CMMError:
+        pytest.skip("SLM does not support sequences")
+    n = min(max_len, 3)
+    stack = np.zeros((n, h, w), np.float32)
+    slm_core.loadSLMSequence("SLM", stack)
+    slm_core.loadSLMSequence("SLM", list(stack))
+
+    with pytest.raises(ValueError, match="dimensions are wrong"):
+        slm_core.loadSLMSequence("SLM", np.zeros((n, h, w + 1), np.uint8))
+
+
+def test_slm_pattern_cache(slm_core: pmn.CMMCore) -> None:
+    h, w = _shape(slm_core)
+    ids = [
+        slm_core.registerSLMPattern("SLM", np.full((h, w), v, np.float32))
+        for v in (0.0, 0.5, 1.0)
+    ]
+    assert len(set(ids)) == 3
+    for pattern_id in ids:
+        slm_core.displaySLMPattern(pattern_id)
+
+    try:
+        slm_core.getSLMSequenceMaxLength("SLM")
+    except pmn.CMMError:
+        pass
+    else:
+        slm_core.loadSLMSequenceByIds(ids)
+
+    assert slm_core.unregisterSLMPattern(ids[0])
+    assert not slm_core.unregisterSLMPattern(ids[0])
+    with pytest.raises(ValueError, match="Unknown SLM pattern"):
+        slm_core.displaySLMPattern(ids[0])
+
+    slm_core.clearSLMPatterns()
+    with pytest.raises(ValueError, match="Unknown SLM pattern"):
+        slm_core.loadSLMSequenceByIds(ids[1:])
@@ -1,4 +1,8 @@
+import time
+
+import numpy as np
 import pymmcore_nano as pmn
+import pytest
 
 Z_STAGE = "Z"
 XY_STAGE = "XY"
@@ -126,3 +130,80 @@ def test_stage_default_device_operations(demo_core: pmn.CMMCore) -> None:
     new_y = demo_core.getYPosition()
     assert isinstance(new_x, float)
     assert isinstance(new_y, float)
+
+
+def test_stage_sequence_arrays(demo_core: pmn.CMMCore) -> None:
+    """Test loading stage sequences from numpy arrays, directly and in chunks."""
+    if demo_core.hasProperty(Z_STAGE, "UseSequences"):
+        demo_core.setProperty(Z_STAGE, "UseSequences", "Yes")
+    if not demo_core.isStageSequenceable(Z_STAGE):
+        pytest.skip("Z stage is not sequenceable")
+
+    max_len = demo_core.getStageSequenceMaxLength(Z_STAGE)
+    if max_len > 1_000_000:
+        pytest.skip("stage sequence limit too large to exceed in a test")
+    demo_core.loadStageSequence(Z_STAGE, np.linspace(0, 10, min(max_len, 100)))
+    demo_core.loadStageSequence(Z_STAGE, [0.0, 1.0, 2.0])
+
+    with pytest.raises(ValueError, match="at most"):
+        demo_core.loadStageSequence(Z_STAGE, np.zeros(max_len + 1))
+    with pytest.raises(ValueError, match="NaN"):
+        demo_core.loadStageSequence(Z_STAGE, np.array([0.0, np.nan]))
+
+    n = max_len * 2 + 1
+    stream = pmn.StageSequenceStream(demo_core, Z_STAGE, np.arange(n, dtype=float))
+    assert stream.chunkSize == max_len
+    assert stream.chunkCount == 3
+    assert stream.currentChunk == -1
+    chunks = 0
+    while stream.advance():
+        chunks += 1
+        assert stream.currentChunk == chunks - 1
+    assert chunks == 3
+    assert not stream.advance(force=True)
+
+
+def test_stage_telemetry(demo_core: pmn.CMMCore) -> None:
+    """Test background stage position sampling."""
+    tel = pmn.StageTelemetry(demo_core, xyStage=XY_STAGE, zStage=Z_STAGE, capacity=5)
+    assert not tel.isRunning()
+    demo_core.setXYPosition(XY_STAGE, 12.0, 34.0)
+    demo_core.setPosition(Z_STAGE, 5.0)
+    demo_core.waitForSystem()
+
+    tel.start(1)
+    assert tel.isRunning()
+    deadline = time.perf_counter() + 2
+    while len(tel) < 5 and time.perf_counter() < deadline:
+        time.sleep(0.01)
+    tel.stop()
+    assert not tel.isRunning()
+
+    t, x, y, z = tel.getSamples()
+    assert len(t) == len(tel) == 5  # capacity bounds the ring buffer
+    assert np.all(np.diff(t) > 0)
+    np.testing.assert_allclose(x, 12.0, atol=0.1)
+    np.testing.assert_allclose(y, 34.0, atol=0.1)
+    np.testing.assert_allclose(z, 5.0, atol=0.1)
+
+    tel.clear()
+    assert len(tel) == 0
+
+    # clearing while sampling must never produce times before the new origin
+    tel.start(1)
+    for _ in range(20):
+        tel.clear()
+        time.sleep(0.002)
+        t, *_ = tel.getSamples()
+        assert np.all(t >= 0)
+    tel.stop()
+
+    z_only = pmn.StageTelemetry(demo_core, zStage=Z_STAGE)
+    z_only.start(1)
+    time.sleep(0.05)
+    z_only.stop()
+    _, x, _, z = z_only.getSamples()
+    assert len(z) > 0 and np.isnan(x).all()
+
+    with pytest.raises(ValueError):
+        pmn.StageTelemetry(demo_core)